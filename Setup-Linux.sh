@@ -12,10 +12,12 @@ echo ""
 echo "Installing..."
 
 #Compile
-gcc -std=gnu99 -pedantic -O3 -c aal.c -lm
+gcc -std=gnu99 -pedantic -O3 -pthread -c aal.c threadpool.c -lm
 
 #Link
-gcc -o specter console.c aal.c -lm
+gcc -pthread -o specter console.c aal.c threadpool.c -lm
+gcc -std=gnu99 -O3 -pthread -o benchmark benchmark.c aal.c threadpool.c -lm
+gcc -std=gnu99 -O3 -pthread -o tune tune.c aal.c threadpool.c -lm
 
 #Clean up
 rm *.o
@@ -11,12 +11,80 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#ifdef AAL_STATS
+#include <time.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-typedef struct {
-    char *digits;   // only digits, no decimal point
-    int scale;      // number of fractional digits
-    int sign;       // +1 or -1
-} BigFloat;
+#include "headers/aal.h"
+#include "headers/threadpool.h"
+
+// x86-64 builds get vector add/sub kernels: SSE2 is always there, AVX2 is
+// picked at run time
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(AAL_NO_SIMD)
+#define AAL_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// The *_CUTOFF values are defaults: setAALThresholds and loadAALThresholds
+// replace them at run time
+
+// Multiplication tiers by operand size in limbs: schoolbook up to
+// KARATSUBA_CUTOFF, then Karatsuba, Toom-3 from TOOM3_CUTOFF, Toom-4 from
+// TOOM4_CUTOFF and the NTT from NTT_CUTOFF
+#ifndef KARATSUBA_CUTOFF
+#define KARATSUBA_CUTOFF 24
+#endif
+#ifndef TOOM3_CUTOFF
+#define TOOM3_CUTOFF 150
+#endif
+#ifndef TOOM4_CUTOFF
+#define TOOM4_CUTOFF 500
+#endif
+#ifndef NTT_CUTOFF
+#define NTT_CUTOFF 2000
+#endif
+
+// Division tiers by divisor and quotient size in limbs: long division below
+// BZ_CUTOFF, Burnikel-Ziegler below NEWTON_CUTOFF, Newton reciprocals above
+#ifndef BZ_CUTOFF
+#define BZ_CUTOFF 60
+#endif
+#ifndef NEWTON_CUTOFF
+#define NEWTON_CUTOFF 20000
+#endif
+
+// longest product the NTT primes can transform (2^23 divides p0 - 1)
+#define NTT_MAX_LEN (1 << 23)
+
+// Short products fall back to schoolbook once the shorter operand has at
+// most MULHIGH_CUTOFF limbs
+#ifndef MULHIGH_CUTOFF
+#define MULHIGH_CUTOFF 48
+#endif
+
+// Products below PARALLEL_CUTOFF limbs stay on the calling thread
+#ifndef PARALLEL_CUTOFF
+#define PARALLEL_CUTOFF 2000
+#endif
+
+// Radix conversion splits numbers of more than RADIX_CUTOFF limbs on
+// powers of the radix and converts smaller ones limb by limb
+#ifndef RADIX_CUTOFF
+#define RADIX_CUTOFF 30
+#endif
+
+static const limb_t pow10Limb[AAL_LIMB_DIGITS + 1] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u,
+    1000000000u
+};
 
 // ---------- Helpers ----------
 
@@ -36,490 +104,4027 @@ void reverse(char* str) {
     }
 }
 
-// Parse string into BigFloat
-BigFloat parseBigFloat(const char* s) {
-    BigFloat bf;
-    bf.sign = 1;
-    bf.scale = 0;
+// ---------- Statistics ----------
+// Built with AAL_STATS, the public operations count their calls, time and
+// operand sizes, the kernels count the tiers they pick and the allocator
+// tracks its bytes. Counters are updated atomically since pool threads
+// share them. Without AAL_STATS every hook compiles to nothing.
 
-    // normalize sign: handle multiple +/-
-    while (*s == '+' || *s == '-') {
-        if (*s == '-') bf.sign = -bf.sign;
-        s++;
+#ifdef AAL_STATS
+static AALStats aalStats;
+static __thread uint64_t karatsubaDepth = 0;   // per thread, so pool tasks start over
+
+static uint64_t statsNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void statsMax(uint64_t* field, uint64_t v) {
+    uint64_t seen = __atomic_load_n(field, __ATOMIC_RELAXED);
+    while (v > seen && !__atomic_compare_exchange_n(field, &seen, v, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// Histogram bucket of an n limb operand: the bit length of n
+static int statsBucket(int n) {
+    int b = 0;
+    while (n > 0 && b < AAL_STAT_SIZE_BUCKETS - 1) {
+        n >>= 1;
+        b++;
+    }
+    return b;
+}
+
+typedef struct {
+    AALStatOp op;
+    uint64_t start;
+} StatsTimer;
+
+static StatsTimer statsStart(AALStatOp op, int limbs) {
+    StatsTimer t;
+    t.op = op;
+    __atomic_add_fetch(&aalStats.calls[op], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&aalStats.sizes[op][statsBucket(limbs)], 1, __ATOMIC_RELAXED);
+    t.start = statsNow();
+    return t;
+}
+
+static void statsStop(StatsTimer* t) {
+    __atomic_add_fetch(&aalStats.ns[t->op], statsNow() - t->start, __ATOMIC_RELAXED);
+}
+
+static void statsBytes(int64_t delta) {
+    if (delta > 0) __atomic_add_fetch(&aalStats.bytesAllocated, (uint64_t)delta, __ATOMIC_RELAXED);
+    uint64_t live = __atomic_add_fetch(&aalStats.liveBytes, (uint64_t)delta, __ATOMIC_RELAXED);
+    statsMax(&aalStats.peakLiveBytes, live);
+}
+
+// Time the rest of the enclosing function as op; limbs sizes its operands
+#define STATS_OP(op, limbs) \
+    StatsTimer statsTimer __attribute__((cleanup(statsStop))) = statsStart(op, limbs)
+#define STATS_COUNT(counter) __atomic_add_fetch(&aalStats.counter, 1, __ATOMIC_RELAXED)
+#define STATS_BYTES(delta) statsBytes(delta)
+#define STATS_DEPTH_IN() statsMax(&aalStats.karatsubaDepth, ++karatsubaDepth)
+#define STATS_DEPTH_OUT() (karatsubaDepth--)
+#else
+#define STATS_OP(op, limbs) ((void)0)
+#define STATS_COUNT(counter) ((void)0)
+#define STATS_BYTES(delta) ((void)0)
+#define STATS_DEPTH_IN() ((void)0)
+#define STATS_DEPTH_OUT() ((void)0)
+#endif
+
+// Copy the statistics so far into stats; returns 0, with stats zeroed,
+// when the library was built without AAL_STATS
+int snapshotAALStats(AALStats* stats) {
+#ifdef AAL_STATS
+    const uint64_t* from = (const uint64_t*)&aalStats;
+    uint64_t* to = (uint64_t*)stats;
+    for (size_t i = 0; i < sizeof(AALStats) / sizeof(uint64_t); i++) {
+        to[i] = __atomic_load_n(&from[i], __ATOMIC_RELAXED);
     }
+    return 1;
+#else
+    memset(stats, 0, sizeof(AALStats));
+    return 0;
+#endif
+}
 
-    // must start with digit or dot now
-    if (!isdigit(*s) && *s != '.') {
-        fprintf(stderr, "Invalid number format: %s\n", s);
-        bf.digits = strdup("0");
-        bf.sign = 1;
-        bf.scale = 0;
-        return bf;
+// Start the counters over; live bytes stay, as their buffers still do
+void resetAALStats(void) {
+#ifdef AAL_STATS
+    uint64_t live = __atomic_load_n(&aalStats.liveBytes, __ATOMIC_RELAXED);
+    uint64_t* word = (uint64_t*)&aalStats;
+    for (size_t i = 0; i < sizeof(AALStats) / sizeof(uint64_t); i++) {
+        __atomic_store_n(&word[i], 0, __ATOMIC_RELAXED);
     }
+    __atomic_store_n(&aalStats.liveBytes, live, __ATOMIC_RELAXED);
+    __atomic_store_n(&aalStats.peakLiveBytes, live, __ATOMIC_RELAXED);
+#endif
+}
 
-    const char *dot = strchr(s, '.');
-    if (dot) {
-        bf.scale = strlen(dot+1);
-        bf.digits = malloc(strlen(s)+1);
-        int k=0;
-        for (int i=0; s[i]; i++) {
-            if (s[i] != '.') bf.digits[k++] = s[i];
+static const char* const statOpNames[AAL_STAT_OPS] = {
+    "parse", "format", "add", "sub", "mul", "sqr", "div", "sqrt", "pow", "modmul", "modpow"
+};
+
+// Dump a snapshot as one JSON object; returns 0, or -1 on a write error
+int writeAALStatsJson(FILE* f) {
+    static const char* const mulNames[] = { "schoolbook", "karatsuba", "toom3", "toom4", "ntt" };
+    static const char* const divNames[] = { "long", "burnikel_ziegler", "newton" };
+    AALStats s;
+    int enabled = snapshotAALStats(&s);
+
+    fprintf(f, "{\"enabled\": %s", enabled ? "true" : "false");
+    if (enabled) {
+        // operations that ran, with their operand sizes up to the largest
+        fprintf(f, ", \"ops\": {");
+        for (int op = 0, first = 1; op < AAL_STAT_OPS; op++) {
+            if (!s.calls[op]) continue;
+            int top = AAL_STAT_SIZE_BUCKETS - 1;
+            while (top > 0 && !s.sizes[op][top]) top--;
+            fprintf(f, "%s\"%s\": {\"calls\": %llu, \"ns\": %llu, \"limb_bits\": [", first ? "" : ", ",
+                    statOpNames[op], (unsigned long long)s.calls[op], (unsigned long long)s.ns[op]);
+            for (int b = 0; b <= top; b++) {
+                fprintf(f, "%s%llu", b ? ", " : "", (unsigned long long)s.sizes[op][b]);
+            }
+            fprintf(f, "]}");
+            first = 0;
         }
-        bf.digits[k] = '\0';
-    } else {
-        bf.digits = strdup(s);
+        fprintf(f, "}, \"mul_tiers\": {");
+        for (int t = AAL_MUL_SCHOOLBOOK; t <= AAL_MUL_NTT; t++) {
+            fprintf(f, "%s\"%s\": %llu", t > AAL_MUL_SCHOOLBOOK ? ", " : "", mulNames[t - AAL_MUL_SCHOOLBOOK],
+                    (unsigned long long)s.mulTiers[t]);
+        }
+        fprintf(f, "}, \"div_tiers\": {");
+        for (int t = 0; t < 3; t++) {
+            fprintf(f, "%s\"%s\": %llu", t ? ", " : "", divNames[t], (unsigned long long)s.divTiers[t]);
+        }
+        fprintf(f, "}, \"karatsuba_depth\": %llu, \"bytes_allocated\": %llu, \"live_bytes\": %llu, "
+                "\"peak_live_bytes\": %llu",
+                (unsigned long long)s.karatsubaDepth, (unsigned long long)s.bytesAllocated,
+                (unsigned long long)s.liveBytes, (unsigned long long)s.peakLiveBytes);
+    }
+    fprintf(f, "}\n");
+    return ferror(f) ? -1 : 0;
+}
+
+// ---------- Thresholds ----------
+// The crossover points the dispatchers read. The tune tool finds them by
+// timing each tier against the one below it and saves them in a file of
+// "name value" lines, which loadAALThresholds reads back.
+
+static AALThresholds cutoffs = {
+    KARATSUBA_CUTOFF, TOOM3_CUTOFF, TOOM4_CUTOFF, NTT_CUTOFF, MULHIGH_CUTOFF,
+    BZ_CUTOFF, NEWTON_CUTOFF, PARALLEL_CUTOFF, RADIX_CUTOFF
+};
+
+static const struct {
+    const char* name;
+    size_t offset;
+} thresholdNames[] = {
+    {"karatsuba", offsetof(AALThresholds, karatsuba)},
+    {"toom3",     offsetof(AALThresholds, toom3)},
+    {"toom4",     offsetof(AALThresholds, toom4)},
+    {"ntt",       offsetof(AALThresholds, ntt)},
+    {"mulhigh",   offsetof(AALThresholds, mulHigh)},
+    {"bz",        offsetof(AALThresholds, bz)},
+    {"newton",    offsetof(AALThresholds, newton)},
+    {"parallel",  offsetof(AALThresholds, parallel)},
+    {"radix",     offsetof(AALThresholds, radix)}
+};
+
+#define THRESHOLD_COUNT (int)(sizeof(thresholdNames) / sizeof(thresholdNames[0]))
+
+static int* thresholdField(AALThresholds* t, int i) {
+    return (int*)((char*)t + thresholdNames[i].offset);
+}
+
+void getAALThresholds(AALThresholds* t) {
+    *t = cutoffs;
+}
+
+// Take a new set of crossover points; returns 0, or -1 (keeping the old
+// set) when the tiers are out of order or too small for their algorithms:
+// Toom-3 needs 5 limbs and Toom-4 10 to split into their pieces
+int setAALThresholds(const AALThresholds* t) {
+    if (t->karatsuba < 1 || t->toom3 <= t->karatsuba || t->toom3 < 5 ||
+        t->toom4 < t->toom3 || t->toom4 < 10 || t->ntt < t->toom4 ||
+        t->mulHigh < 2 || t->bz < 4 || t->newton < 8 || t->parallel < 2 || t->radix < 2) {
+        fprintf(stderr, "Invalid thresholds!\n");
+        return -1;
     }
+    cutoffs = *t;
+    return 0;
+}
 
-    // strip leading zeros
-    bf.digits = stripLeadingZeros(bf.digits);
-    if (*bf.digits == '\0') { 
-        bf.digits = strdup("0"); 
-        bf.scale = 0; 
-        bf.sign = 1; 
+// Read a thresholds file over the current set; names it leaves out keep
+// their values and lines starting with # are comments. A NULL path reads
+// $AAL_THRESHOLDS, if set. Returns 0, or -1 with the set unchanged
+int loadAALThresholds(const char* path) {
+    if (!path) {
+        path = getenv("AAL_THRESHOLDS");
+        if (!path || !*path) return 0;
+    }
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Could not open thresholds file %s!\n", path);
+        return -1;
     }
 
-    return bf;
+    AALThresholds t = cutoffs;
+    char line[256], name[64];
+    long value;
+    int ok = 1;
+    while (ok && fgets(line, sizeof(line), f)) {
+        char* p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') continue;
+        ok = sscanf(p, "%63s %ld", name, &value) == 2 && value > 0 && value <= INT_MAX;
+        int i = 0;
+        while (ok && i < THRESHOLD_COUNT && strcmp(name, thresholdNames[i].name) != 0) i++;
+        if (!ok || i == THRESHOLD_COUNT) {
+            fprintf(stderr, "Bad thresholds line: %s", line);
+            ok = 0;
+        } else {
+            *thresholdField(&t, i) = (int)value;
+        }
+    }
+    fclose(f);
+    return (ok && setAALThresholds(&t) == 0) ? 0 : -1;
 }
 
-// Format BigFloat as string
-char* formatBigFloat(BigFloat bf) {
-    int len = strlen(bf.digits);
-    int pointPos = len - bf.scale;
+// Write t in the form loadAALThresholds reads; returns 0, or -1 on a
+// write error
+int writeAALThresholds(FILE* f, const AALThresholds* t) {
+    AALThresholds c = *t;
+    for (int i = 0; i < THRESHOLD_COUNT; i++) {
+        fprintf(f, "%s %d\n", thresholdNames[i].name, *thresholdField(&c, i));
+    }
+    return ferror(f) ? -1 : 0;
+}
 
-    // Ensure pointPos >= 1
-    if (pointPos <= 0) {
-        // need leading zeros like 0.00123
-        char* res = calloc(2 + bf.scale + len + 2, 1);
-        int k = 0;
-        if (bf.sign < 0) res[k++] = '-';
-        res[k++] = '0';
-        res[k++] = '.';
-        for (int i=0; i < -pointPos; i++) res[k++] = '0';
-        strcpy(res+k, bf.digits);
-        return res;
+// ---------- Evaluation contexts ----------
+// A context carves limb buffers out of large arena chunks, rounded up to
+// power of two size classes. Freed buffers go onto a per class free list
+// for reuse, and a reset rewinds the arena and empties the lists without
+// touching the chunks, so it costs the same however much was allocated.
+// Contexts are not shared between threads.
+
+#define CONTEXT_CLASSES 32
+#define CONTEXT_MIN_CLASS 2
+#define CONTEXT_CHUNK_BYTES (1 << 20)
+
+typedef struct ArenaChunk {
+    struct ArenaChunk* next;
+    size_t size;        // usable bytes after the header
+    size_t used;
+    size_t pad;         // keeps the data 16 byte aligned
+} ArenaChunk;
+
+struct AALContext {
+    ArenaChunk* first;
+    ArenaChunk* current;    // chunks after current are unused
+    void* freeList[CONTEXT_CLASSES];
+    uint32_t generation;
+    size_t chunkBytes;
+#ifdef AAL_STATS
+    int64_t liveBytes;      // in blocks handed out since the last reset
+#endif
+};
+
+// Every limb buffer is preceded by a header naming its owner
+typedef struct {
+    AALContext* ctx;        // NULL for heap blocks
+    uint32_t generation;    // context generation the block was carved in
+    uint32_t sizeClass;
+} LimbHeader;
+
+static __thread AALContext* currentContext = NULL;
+
+// Owner named by limb buffers that sit in a file mapped by loadBigFloat
+static AALContext mappedFile;
+static void unmapLimbs(limb_t* p);
+
+static ArenaChunk* contextChunk(size_t size) {
+    ArenaChunk* c = malloc(sizeof(ArenaChunk) + size);
+    if (!c) {
+        fprintf(stderr, "Out of memory!\n");
+        exit(1);
     }
+    c->next = NULL;
+    c->size = size;
+    c->used = 0;
+    return c;
+}
 
-    // normal case
-    char* res = calloc(len+3, 1);
-    int k=0;
-    if (bf.sign < 0) res[k++] = '-';
-    for (int i=0; i<len; i++) {
-        if (i == pointPos) res[k++]='.';
-        res[k++] = bf.digits[i];
+// Create a context whose arena grows in chunkBytes steps (0 for the default)
+AALContext* createAALContext(size_t chunkBytes) {
+    AALContext* ctx = calloc(1, sizeof(AALContext));
+    if (!ctx) {
+        fprintf(stderr, "Out of memory!\n");
+        exit(1);
     }
-    res[k] = '\0';
+    ctx->chunkBytes = chunkBytes ? chunkBytes : CONTEXT_CHUNK_BYTES;
+    ctx->first = ctx->current = contextChunk(ctx->chunkBytes);
+    return ctx;
+}
+
+// Drop everything allocated from ctx in O(1); the arena is kept for reuse
+// and BigFloats from before the reset must not be used afterwards
+void resetAALContext(AALContext* ctx) {
+#ifdef AAL_STATS
+    STATS_BYTES(-ctx->liveBytes);
+    ctx->liveBytes = 0;
+#endif
+    ctx->current = ctx->first;
+    ctx->first->used = 0;
+    memset(ctx->freeList, 0, sizeof(ctx->freeList));
+    ctx->generation++;
+}
 
-    // strip trailing zeros after decimal
-    if (strchr(res, '.')) {
-        char *end = res + strlen(res)-1;
-        while (*end=='0') *end--='\0';
-        if (*end=='.') *end='\0';
+void destroyAALContext(AALContext* ctx) {
+    if (!ctx) return;
+    if (currentContext == ctx) currentContext = NULL;
+#ifdef AAL_STATS
+    STATS_BYTES(-ctx->liveBytes);
+#endif
+    for (ArenaChunk* c = ctx->first; c; ) {
+        ArenaChunk* next = c->next;
+        free(c);
+        c = next;
     }
+    free(ctx);
+}
 
-    return res;
+// Make ctx the calling thread's allocation context (NULL for the heap),
+// returns the previous one
+AALContext* useAALContext(AALContext* ctx) {
+    AALContext* prev = currentContext;
+    currentContext = ctx;
+    return prev;
 }
 
-// Pads a number with leading zeros to a given length
-static char* padLeft(const char* s, int len) {
-    int ls = strlen(s);
-    char* res = calloc(len+1, 1);
-    memset(res, '0', len-ls);
-    strcpy(res+(len-ls), s);
-    return res;
+// Carve a block for n limbs out of the context
+static limb_t* contextAlloc(AALContext* ctx, int n) {
+    uint32_t cls = CONTEXT_MIN_CLASS;
+    while (((size_t)1 << cls) < (size_t)n) cls++;
+#ifdef AAL_STATS
+    ctx->liveBytes += ((int64_t)1 << cls) * sizeof(limb_t);
+    STATS_BYTES(((int64_t)1 << cls) * sizeof(limb_t));
+#endif
+
+    // reuse a freed block of the same class first
+    limb_t* p = ctx->freeList[cls];
+    if (p) {
+        ctx->freeList[cls] = *(void**)p;
+        return p;
+    }
+
+    size_t bytes = sizeof(LimbHeader) + ((size_t)1 << cls) * sizeof(limb_t);
+    bytes = (bytes + 15) & ~(size_t)15;
+    ArenaChunk* c = ctx->current;
+    while (c->size - c->used < bytes) {
+        if (!c->next || c->next->size < bytes) {
+            // splice in a chunk big enough, keeping the unused ones after it
+            size_t size = (bytes > ctx->chunkBytes) ? bytes : ctx->chunkBytes;
+            ArenaChunk* fresh = contextChunk(size);
+            fresh->next = c->next;
+            c->next = fresh;
+        }
+        c = c->next;
+        c->used = 0;
+    }
+    ctx->current = c;
+
+    LimbHeader* h = (LimbHeader*)((char*)(c + 1) + c->used);
+    c->used += bytes;
+    h->ctx = ctx;
+    h->generation = ctx->generation;
+    h->sizeClass = cls;
+    return (limb_t*)(h + 1);
 }
 
-// Compare two positive integers in string form
-int compareDigits(const char* a, const char* b) {
-    int la = strlen(a), lb = strlen(b);
+// ---------- Limb kernels ----------
+// Magnitudes are arrays of base 10^9 limbs, least significant limb first.
+
+// Allocate a limb buffer (never returns a zero sized block), from the
+// thread's current context when one is in use
+static limb_t* limbsAlloc(int n) {
+    if (currentContext) return contextAlloc(currentContext, n);
+
+    LimbHeader* h = malloc(sizeof(LimbHeader) + (n > 0 ? n : 1) * sizeof(limb_t));
+    if (!h) {
+        fprintf(stderr, "Out of memory!\n");
+        exit(1);
+    }
+    h->ctx = NULL;
+#ifdef AAL_STATS
+    // heap blocks have no size class, so the slot keeps their size
+    h->sizeClass = (n > 0) ? n : 1;
+    STATS_BYTES((int64_t)h->sizeClass * sizeof(limb_t));
+#endif
+    return (limb_t*)(h + 1);
+}
+
+// Release a buffer from limbsAlloc, to the heap or its context's pool
+static void limbsFree(limb_t* p) {
+    if (!p) return;
+    LimbHeader* h = (LimbHeader*)p - 1;
+    if (!h->ctx) {
+        STATS_BYTES(-(int64_t)h->sizeClass * (int64_t)sizeof(limb_t));
+        free(h);
+        return;
+    }
+    if (h->ctx == &mappedFile) {
+        unmapLimbs(p);
+        return;
+    }
+
+    // blocks from before the last reset are already reclaimed
+    if (h->generation != h->ctx->generation) return;
+#ifdef AAL_STATS
+    h->ctx->liveBytes -= ((int64_t)1 << h->sizeClass) * sizeof(limb_t);
+    STATS_BYTES(-((int64_t)1 << h->sizeClass) * (int64_t)sizeof(limb_t));
+#endif
+    *(void**)p = h->ctx->freeList[h->sizeClass];
+    h->ctx->freeList[h->sizeClass] = p;
+}
+
+// Length of a magnitude once leading zero limbs are dropped
+static int limbsNormLen(const limb_t* a, int n) {
+    while (n > 0 && a[n-1] == 0) n--;
+    return n;
+}
+
+// Number of decimal digits in a single limb
+static int limbDigits(limb_t v) {
+    int d = 1;
+    while (d < AAL_LIMB_DIGITS && v >= pow10Limb[d]) d++;
+    return d;
+}
+
+// Compare two normalized magnitudes
+static int limbsCmp(const limb_t* a, int la, const limb_t* b, int lb) {
     if (la != lb) return (la > lb) ? 1 : -1;
-    return strcmp(a,b);
+    for (int i = la-1; i >= 0; i--) {
+        if (a[i] != b[i]) return (a[i] > b[i]) ? 1 : -1;
+    }
+    return 0;
 }
 
-// Integer addition: |a| + |b|
-char* addDigits(const char* a, const char* b) {
-    int la = strlen(a), lb = strlen(b);
-    int max = (la > lb ? la : lb) + 1;
-    char* res = calloc(max+1, 1);
+#ifdef AAL_SIMD_X86
+// Vector add/sub: each lane forms a[i] +/- b[i], then the carries (or
+// borrows) between lanes are resolved all at once from two bit masks,
+// G for lanes that overflow by themselves and P for lanes that only pass
+// an incoming carry on (sum == B-1, or difference == 0). Treating the
+// masks as integers, the lanes receiving a carry are ((G<<1 | cin) + P) ^ P
+// and the carry out of the vector is what spills past the top lane.
 
-    int carry = 0, i = la-1, j = lb-1, k = max-1;
-    res[max] = '\0';
-    while (i >= 0 || j >= 0 || carry) {
-        int da = (i>=0) ? a[i--]-'0' : 0;
-        int db = (j>=0) ? b[j--]-'0' : 0;
-        int sum = da + db + carry;
-        res[k--] = (sum % 10) + '0';
-        carry = sum/10;
+static int simdLevel = -1;
+
+// 2 when AVX2 is usable, 1 for the SSE2 baseline
+static int limbsSimdLevel(void) {
+    if (simdLevel < 0) {
+        __builtin_cpu_init();
+        simdLevel = __builtin_cpu_supports("avx2") ? 2 : 1;
     }
+    return simdLevel;
+}
 
-    char* trimmed = stripLeadingZeros(res+k+1);
-    return strdup(trimmed);
+// Spread the low 8 bits of mask over lanes as 0/1
+__attribute__((target("avx2")))
+static inline __m256i laneBits256(unsigned mask) {
+    const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i m = _mm256_and_si256(_mm256_set1_epi32((int)mask), bits);
+    return _mm256_srli_epi32(_mm256_cmpeq_epi32(m, bits), 31);
 }
 
-// Integer subtraction: |a| - |b|, assumes |a| >= |b|
-char* subDigits(const char* a, const char* b) {
-    int la = strlen(a), lb = strlen(b);
-    char* res = calloc(la+1, 1);
+// n must be a multiple of 8
+__attribute__((target("avx2")))
+static limb_t limbsAddNAvx2(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t carry) {
+    const __m256i base = _mm256_set1_epi32(AAL_LIMB_BASE);
+    const __m256i top = _mm256_set1_epi32(AAL_LIMB_BASE - 1);
+    for (int i = 0; i < n; i += 8) {
+        __m256i s = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                     _mm256_loadu_si256((const __m256i*)(b + i)));
+        unsigned g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, top)));
+        unsigned p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(s, top)));
+        unsigned c = ((g << 1) | carry) + p;
+        carry = (c >> 8) != 0;
+        s = _mm256_add_epi32(s, laneBits256(c ^ p));
+        s = _mm256_sub_epi32(s, _mm256_and_si256(_mm256_cmpgt_epi32(s, top), base));
+        _mm256_storeu_si256((__m256i*)(r + i), s);
+    }
+    return carry;
+}
 
-    int borrow = 0, i = la-1, j = lb-1, k = la-1;
-    while (i >= 0) {
-        int da = a[i]-'0' - borrow;
-        int db = (j>=0) ? b[j]-'0' : 0;
-        if (da < db) { da += 10; borrow=1; }
-        else borrow=0;
-        res[k--] = (da - db) + '0';
-        i--; j--;
+// n must be a multiple of 8
+__attribute__((target("avx2")))
+static limb_t limbsSubNAvx2(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t borrow) {
+    const __m256i base = _mm256_set1_epi32(AAL_LIMB_BASE);
+    const __m256i zero = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 8) {
+        __m256i d = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                     _mm256_loadu_si256((const __m256i*)(b + i)));
+        unsigned g = _mm256_movemask_ps(_mm256_castsi256_ps(d));
+        unsigned p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(d, zero)));
+        unsigned c = ((g << 1) | borrow) + p;
+        borrow = (c >> 8) != 0;
+        d = _mm256_sub_epi32(d, laneBits256(c ^ p));
+        d = _mm256_add_epi32(d, _mm256_and_si256(_mm256_cmpgt_epi32(zero, d), base));
+        _mm256_storeu_si256((__m256i*)(r + i), d);
     }
+    return borrow;
+}
 
-    char* trimmed = stripLeadingZeros(res);
-    return strdup(trimmed);
+// Spread the low 4 bits of mask over lanes as 0/1
+static inline __m128i laneBits128(unsigned mask) {
+    const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i m = _mm_and_si128(_mm_set1_epi32((int)mask), bits);
+    return _mm_srli_epi32(_mm_cmpeq_epi32(m, bits), 31);
 }
 
-// BigFloat addition
-BigFloat addBigFloat(BigFloat a, BigFloat b) {
-    BigFloat res;
+// n must be a multiple of 4
+static limb_t limbsAddNSse2(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t carry) {
+    const __m128i base = _mm_set1_epi32(AAL_LIMB_BASE);
+    const __m128i top = _mm_set1_epi32(AAL_LIMB_BASE - 1);
+    for (int i = 0; i < n; i += 4) {
+        __m128i s = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(a + i)),
+                                  _mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned g = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, top)));
+        unsigned p = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(s, top)));
+        unsigned c = ((g << 1) | carry) + p;
+        carry = (c >> 4) != 0;
+        s = _mm_add_epi32(s, laneBits128(c ^ p));
+        s = _mm_sub_epi32(s, _mm_and_si128(_mm_cmpgt_epi32(s, top), base));
+        _mm_storeu_si128((__m128i*)(r + i), s);
+    }
+    return carry;
+}
 
-    // align scales
-    if (a.scale > b.scale) {
-        int diff = a.scale - b.scale;
-        char* tmp = calloc(strlen(b.digits)+diff+1,1);
-        strcpy(tmp, b.digits);
-        for (int i=0;i<diff;i++) strcat(tmp,"0");
-        b.digits = tmp;
-        b.scale = a.scale;
-    } else if (b.scale > a.scale) {
-        int diff = b.scale - a.scale;
-        char* tmp = calloc(strlen(a.digits)+diff+1,1);
-        strcpy(tmp, a.digits);
-        for (int i=0;i<diff;i++) strcat(tmp,"0");
-        a.digits = tmp;
-        a.scale = b.scale;
-    }
-
-    res.scale = a.scale;
-
-    if (a.sign == b.sign) {
-        res.digits = addDigits(a.digits, b.digits);
-        res.sign = a.sign;
-    } else {
-        int cmp = compareDigits(a.digits, b.digits);
-        if (cmp == 0) {
-            res.digits = strdup("0");
-            res.sign = 1;
-            res.scale = 0;
-        } else if (cmp > 0) {
-            res.digits = subDigits(a.digits, b.digits);
-            res.sign = a.sign;
+// n must be a multiple of 4
+static limb_t limbsSubNSse2(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t borrow) {
+    const __m128i base = _mm_set1_epi32(AAL_LIMB_BASE);
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 4) {
+        __m128i d = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(a + i)),
+                                  _mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned g = _mm_movemask_ps(_mm_castsi128_ps(d));
+        unsigned p = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(d, zero)));
+        unsigned c = ((g << 1) | borrow) + p;
+        borrow = (c >> 4) != 0;
+        d = _mm_sub_epi32(d, laneBits128(c ^ p));
+        d = _mm_add_epi32(d, _mm_and_si128(_mm_cmpgt_epi32(zero, d), base));
+        _mm_storeu_si128((__m128i*)(r + i), d);
+    }
+    return borrow;
+}
+#endif
+
+// r = a + b over n limbs, returns the carry out
+static limb_t limbsAddN(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    limb_t carry = 0;
+    int i = 0;
+#ifdef AAL_SIMD_X86
+    if (n >= 8) {
+        if (limbsSimdLevel() == 2) {
+            i = n & ~7;
+            carry = limbsAddNAvx2(r, a, b, i, 0);
         } else {
-            res.digits = subDigits(b.digits, a.digits);
-            res.sign = b.sign;
+            i = n & ~3;
+            carry = limbsAddNSse2(r, a, b, i, 0);
         }
     }
+#endif
+    for (; i < n; i++) {
+        limb_t s = a[i] + b[i] + carry;
+        carry = (s >= AAL_LIMB_BASE);
+        r[i] = carry ? s - AAL_LIMB_BASE : s;
+    }
+    return carry;
+}
 
-    return res;
+// r = a + b where la >= lb, returns the carry out of limb la-1
+static limb_t limbsAdd(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb) {
+    limb_t carry = limbsAddN(r, a, b, lb);
+    int i = lb;
+    for (; i < la && carry; i++) {
+        limb_t s = a[i] + 1;
+        carry = (s == AAL_LIMB_BASE);
+        r[i] = carry ? 0 : s;
+    }
+    if (r != a && i < la) memcpy(r+i, a+i, (la-i)*sizeof(limb_t));
+    return carry;
 }
 
-// BigFloat subtraction: a - b
-BigFloat subBigFloat(BigFloat a, BigFloat b) {
-    BigFloat negB = b;
-    negB.sign = -negB.sign;   // flip the sign of b
-    return addBigFloat(a, negB);
+// r = a - b over n limbs, returns the borrow out
+static limb_t limbsSubN(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    limb_t borrow = 0;
+    int i = 0;
+#ifdef AAL_SIMD_X86
+    if (n >= 8) {
+        if (limbsSimdLevel() == 2) {
+            i = n & ~7;
+            borrow = limbsSubNAvx2(r, a, b, i, 0);
+        } else {
+            i = n & ~3;
+            borrow = limbsSubNSse2(r, a, b, i, 0);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        limb_t sub = b[i] + borrow;
+        borrow = (a[i] < sub);
+        r[i] = borrow ? a[i] + AAL_LIMB_BASE - sub : a[i] - sub;
+    }
+    return borrow;
 }
 
-// Base case used for numbers with less than karatsuba cutoff number of digits
-char* mulBase(const char* a, const char* b) {
-    int la = strlen(a), lb = strlen(b);
-    int len = la + lb;
-    int* tmp = calloc(len, sizeof(int));
+// r = a - b where la >= lb, returns the borrow out of limb la-1
+static limb_t limbsSub(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb) {
+    limb_t borrow = limbsSubN(r, a, b, lb);
+    int i = lb;
+    for (; i < la && borrow; i++) {
+        borrow = (a[i] == 0);
+        r[i] = borrow ? AAL_LIMB_BASE - 1 : a[i] - 1;
+    }
+    if (r != a && i < la) memcpy(r+i, a+i, (la-i)*sizeof(limb_t));
+    return borrow;
+}
 
-    // multiply each digit
-    for (int i = la-1; i >= 0; i--) {
-        for (int j = lb-1; j >= 0; j--) {
-            int prod = (a[i]-'0') * (b[j]-'0');
-            int p1 = i+j, p2 = i+j+1;
-            int sum = prod + tmp[p2];
-            tmp[p2] = sum % 10;
-            tmp[p1] += sum / 10;
-        }
+// r = a * m for a single limb m, returns the carry limb
+static limb_t limbsMul1(limb_t* r, const limb_t* a, int n, limb_t m) {
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t t = (uint64_t)a[i] * m + carry;
+        carry = t / AAL_LIMB_BASE;
+        r[i] = (limb_t)(t - carry * AAL_LIMB_BASE);
     }
+    return (limb_t)carry;
+}
 
-    // convert to string
-    char* res = calloc(len+1, 1);
-    int k = 0;
-    while (k < len && tmp[k] == 0) k++;  // skip leading zeros
-    if (k == len) {  // all zero
-        strcpy(res, "0");
-    } else {
-        for (int i = k; i < len; i++) res[i-k] = tmp[i] + '0';
+// r += a * m for a single limb m, returns the carry limb
+static limb_t limbsAddMul1(limb_t* r, const limb_t* a, int n, limb_t m) {
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t t = (uint64_t)a[i] * m + r[i] + carry;
+        carry = t / AAL_LIMB_BASE;
+        r[i] = (limb_t)(t - carry * AAL_LIMB_BASE);
     }
+    return (limb_t)carry;
+}
 
-    free(tmp);
-    return res;
+// q = a / d for a single limb d, returns the remainder
+static limb_t limbsDivRem1(limb_t* q, const limb_t* a, int n, limb_t d) {
+    uint64_t rem = 0;
+    for (int i = n-1; i >= 0; i--) {
+        uint64_t t = rem * AAL_LIMB_BASE + a[i];
+        q[i] = (limb_t)(t / d);
+        rem = t % d;
+    }
+    return (limb_t)rem;
+}
+
+// Base case used for numbers with less than karatsuba cutoff number of limbs
+// r holds la+lb limbs and must not overlap the operands
+static void limbsMulBase(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb) {
+    memset(r, 0, la * sizeof(limb_t));
+    for (int j = 0; j < lb; j++) {
+        r[la+j] = limbsAddMul1(r+j, a, la, b[j]);
+    }
+}
+
+// Schoolbook square: each cross product a[i]*a[j] is computed once and doubled
+static void limbsSqrBase(limb_t* r, const limb_t* a, int n) {
+    memset(r, 0, 2*n * sizeof(limb_t));
+    for (int i = 0; i < n-1; i++) {
+        r[n+i] = limbsAddMul1(r + 2*i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+
+    // r = 2*r + diagonal squares
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t sq = (uint64_t)a[i] * a[i];
+        uint64_t lo = 2*(uint64_t)r[2*i] + sq % AAL_LIMB_BASE + carry;
+        r[2*i] = (limb_t)(lo % AAL_LIMB_BASE);
+        uint64_t hi = 2*(uint64_t)r[2*i+1] + sq / AAL_LIMB_BASE + lo / AAL_LIMB_BASE;
+        r[2*i+1] = (limb_t)(hi % AAL_LIMB_BASE);
+        carry = hi / AAL_LIMB_BASE;
+    }
 }
 
-// Karatsuba multiplication, recursive
-char* mulKaratsuba(const char* x, const char* y) {
-    int n = strlen(x);
-    int m = strlen(y);
+// Short product: columns c and up of the la x lb product (la >= lb), that
+// is the sum of a[i]*b[j]*B^(i+j-c) over i+j >= c, into la+lb-c limbs.
+// The columns left out weigh less than c*B^(c+1), so r falls short of
+// floor(a*b / B^c) by less than B^2 whenever c < B. Skipping them halves the
+// work of a schoolbook product when c is about la.
+static void limbsMulHighBase(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb, int c) {
+    memset(r, 0, (la+lb-c) * sizeof(limb_t));
+    for (int j = 0; j < lb; j++) {
+        int i = (c - j > 0) ? c - j : 0;
+        if (i < la) r[la+j-c] = limbsAddMul1(r + i+j-c, a + i, la - i, b[j]);
+    }
+}
 
-    // tune this cutoff length to determine when we use karatsuba
-    if (n <= 32 || m <= 32) {
-        return mulBase(x, y);  // your schoolbook O(n²)
+// |a - b| into r (la limbs, la >= lb), returns +1 when a >= b and -1 otherwise
+static int limbsSubAbs(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb) {
+    int na = limbsNormLen(a, la);
+    if (limbsCmp(a, na, b, limbsNormLen(b, lb)) >= 0) {
+        limbsSub(r, a, la, b, lb);
+        return 1;
     }
+    // a < b, so a fits in lb limbs
+    limbsSubN(r, b, a, lb);
+    memset(r + lb, 0, (la - lb) * sizeof(limb_t));
+    return -1;
+}
 
-    // ensure equal length by padding
-    int len = (n > m ? n : m);
-    if (len % 2 != 0) len++;
-    char* X = padLeft(x, len);
-    char* Y = padLeft(y, len);
+// Signed value living in a scratch span, used by the Toom-Cook evaluation and
+// interpolation steps where intermediate values may go negative
+typedef struct {
+    limb_t* p;
+    int n;      // normalized length
+    int sign;   // +1 or -1
+} SignedLimbs;
 
-    int half = len/2;
-    char* X1 = strndup(X, half);
-    char* X0 = strdup(X+half);
-    char* Y1 = strndup(Y, half);
-    char* Y0 = strdup(Y+half);
+static SignedLimbs signedView(const limb_t* p, int n) {
+    SignedLimbs s = { (limb_t*)p, limbsNormLen(p, n), 1 };
+    return s;
+}
 
-    // recursive calls
-    char* Z2 = mulKaratsuba(X1, Y1);
-    char* Z0 = mulKaratsuba(X0, Y0);
+// r = x + y*ySign; r may share storage with x or y
+static void signedAdd(SignedLimbs* r, SignedLimbs x, SignedLimbs y, int ySign) {
+    y.sign *= ySign;
+    if (x.n < y.n) {
+        SignedLimbs t = x; x = y; y = t;
+    }
+    if (x.sign == y.sign) {
+        limb_t carry = limbsAdd(r->p, x.p, x.n, y.p, y.n);
+        r->p[x.n] = carry;
+        r->n = x.n + carry;
+        r->sign = x.sign;
+    } else if (limbsCmp(x.p, x.n, y.p, y.n) >= 0) {
+        limbsSub(r->p, x.p, x.n, y.p, y.n);
+        r->n = limbsNormLen(r->p, x.n);
+        r->sign = x.sign;
+    } else {
+        limbsSub(r->p, y.p, y.n, x.p, x.n);
+        r->n = limbsNormLen(r->p, y.n);
+        r->sign = y.sign;
+    }
+    if (r->n == 0) r->sign = 1;
+}
 
-    char* X1pX0 = addDigits(X1, X0);
-    char* Y1pY0 = addDigits(Y1, Y0);
-    char* P = mulKaratsuba(X1pX0, Y1pY0);
+// r = x * m for a small m
+static void signedMul1(SignedLimbs* r, SignedLimbs x, limb_t m) {
+    r->p[x.n] = limbsMul1(r->p, x.p, x.n, m);
+    r->n = limbsNormLen(r->p, x.n + 1);
+    r->sign = r->n ? x.sign : 1;
+}
 
-    // Z1 = P - Z2 - Z0
-    char* tmp = subDigits(P, Z2);
-    char* Z1 = subDigits(tmp, Z0);
-    free(tmp);
+// x = x / d where the division is known to be exact
+static void signedDivExact(SignedLimbs* x, limb_t d) {
+    limbsDivRem1(x->p, x->p, x->n, d);
+    x->n = limbsNormLen(x->p, x->n);
+}
 
-    // assemble result = Z2*10^(2*half) + Z1*10^half + Z0
-    int shift1 = 2*half;
-    int shift2 = half;
+// Zero fill a value up to len limbs so it can be used as a fixed size operand
+static void signedPad(SignedLimbs* x, int len) {
+    memset(x->p + x->n, 0, (len - x->n) * sizeof(limb_t));
+}
 
-    char* Z2s = calloc(strlen(Z2)+shift1+1,1);
-    strcpy(Z2s, Z2);
-    for (int i=0; i<shift1; i++) strcat(Z2s, "0");
+// ---------- Parallel multiplication ----------
+// With more than one thread configured, the independent subproducts of
+// Karatsuba and Toom and the per prime NTT convolutions of products of at
+// least the parallel cutoff run on a work stealing pool. Tasks take
+// their scratch from the heap (or the worker's context) since the single
+// scratch area of the serial path can only serve one product at a time.
 
-    char* Z1s = calloc(strlen(Z1)+shift2+1,1);
-    strcpy(Z1s, Z1);
-    for (int i=0; i<shift2; i++) strcat(Z1s, "0");
+static ThreadPool* mulPool = NULL;
 
-    char* sum1 = addDigits(Z2s, Z1s);
-    char* res  = addDigits(sum1, Z0);
+static void limbsMulN(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t* scratch);
+static int mulNScratch(int n);
 
-    // cleanup
-    free(X); free(Y);
-    free(X1); free(X0); free(Y1); free(Y0);
-    free(Z2); free(Z0); free(X1pX0); free(Y1pY0); free(P); free(Z1);
-    free(Z2s); free(Z1s); free(sum1);
+// One n x n product for limbsMulBatch
+typedef struct {
+    limb_t* r;
+    const limb_t* a;
+    const limb_t* b;
+    int n;
+} MulTask;
 
-    return res;
+static int mulParallel(int n) {
+    return mulPool && n >= cutoffs.parallel;
 }
 
-// integration ? 
-char* mulDigits(const char* a, const char* b) {
-    return mulKaratsuba(a, b);  // dispatch to Karatsuba
+static void mulTaskRun(void* arg) {
+    MulTask* t = arg;
+    int need = mulNScratch(t->n);
+    limb_t* scratch = need ? limbsAlloc(need) : NULL;
+    limbsMulN(t->r, t->a, t->b, t->n, scratch);
+    limbsFree(scratch);
 }
 
-// Integer division: returns quotient string (ignores remainder)
-// Computes floor(a / b), where a and b are non-negative digit strings
-// We have to specify the desired level of precision else the calculation will run on forever for repeating fractions etc.
-char* divDigits(const char* a, const char* b, int precision) {
-    if (strcmp(b, "0") == 0) {
-        fprintf(stderr, "Division by zero!\n");
-        return strdup("0");
+// Run count independent products of at most n limbs; the first one always
+// runs here on scratch, the rest go to the pool when n is large enough
+static void limbsMulBatch(MulTask* tasks, int count, int n, limb_t* scratch) {
+    if (!mulParallel(n)) {
+        for (int i = 0; i < count; i++) limbsMulN(tasks[i].r, tasks[i].a, tasks[i].b, tasks[i].n, scratch);
+        return;
     }
 
-    int la = strlen(a);
-    char* quotient = calloc(la + precision + 2, 1); 
-    char* remainder = strdup("0");
+    TaskGroup group = { 0 };
+    for (int i = 1; i < count; i++) threadPoolSpawn(mulPool, &group, mulTaskRun, &tasks[i]);
+    limbsMulN(tasks[0].r, tasks[0].a, tasks[0].b, tasks[0].n, scratch);
+    threadPoolWait(mulPool, &group);
+}
 
-    // Work buffer for dividend digits
-    char* cur = calloc(la + precision + 2, 1);
-    strcpy(cur, a);
+// Use up to threads threads for large products (1 or less for serial);
+// not to be called while a multiplication is running
+void setAALThreads(int threads) {
+    destroyThreadPool(mulPool);
+    mulPool = (threads > 1) ? createThreadPool(threads) : NULL;
+}
 
-    // Append extra zeros for fractional precision
-    for (int i=0; i<precision; i++) strcat(cur, "0");
+int getAALThreads(void) {
+    return threadPoolSize(mulPool);
+}
 
-    int pos = 0;
-    char* prefix = calloc(2,1); prefix[0]='\0';
+// ---------- NTT multiplication ----------
+// Products are computed modulo three NTT primes and recombined with the CRT.
+// Each convolution term is below n*(10^9)^2, which stays under p1*p2*p3 for
+// any transform length the primes support, so the result is exact.
 
-    for (int i=0; cur[i]; i++) {
-        // bring down next digit
-        int plen = strlen(prefix);
-        char* tmp = calloc(plen+2,1);
-        strcpy(tmp,prefix);
-        tmp[plen]=cur[i]; tmp[plen+1]='\0';
+typedef struct {
+    uint32_t p;      // prime, p = c*2^k + 1
+    uint32_t g;      // primitive root mod p
+    uint32_t pinv;   // -p^-1 mod 2^32, for Montgomery reduction
+    uint32_t r2;     // 2^64 mod p, converts into Montgomery form
+} NttPrime;
 
-        free(prefix);
-        prefix = stripLeadingZeros(tmp);
+static const uint32_t nttModuli[3] = { 998244353u, 167772161u, 469762049u };
 
-        // find quotient digit by trial
-        int q=0;
-        while (compareDigits(prefix,b) >= 0) {
-            char* t = subDigits(prefix,b);
-            free(prefix);
-            prefix = t;
-            q++;
-        }
-        quotient[pos++] = q+'0';
+static uint32_t powMod(uint32_t a, uint64_t e, uint32_t p) {
+    uint64_t r = 1, x = a % p;
+    while (e) {
+        if (e & 1) r = r * x % p;
+        x = x * x % p;
+        e >>= 1;
     }
+    return (uint32_t)r;
+}
 
-    quotient[pos] = '\0';
-    free(prefix);
-    free(cur);
-    free(remainder);
+static NttPrime nttPrime(int i) {
+    NttPrime P;
+    P.p = nttModuli[i];
+    P.g = 3;
+    uint32_t inv = P.p;
+    for (int k = 0; k < 5; k++) inv *= 2 - P.p * inv;
+    P.pinv = -inv;
+    uint64_t r = ((uint64_t)1 << 32) % P.p;
+    P.r2 = (uint32_t)(r * r % P.p);
+    return P;
+}
 
-    // strip leading zeros
-    char* trimmed = stripLeadingZeros(quotient);
-    return strdup(trimmed);
+// a*b*2^-32 mod p
+static inline uint32_t montMul(uint32_t a, uint32_t b, const NttPrime* P) {
+    uint64_t t = (uint64_t)a * b;
+    uint32_t m = (uint32_t)t * P->pinv;
+    uint32_t u = (uint32_t)((t + (uint64_t)m * P->p) >> 32);
+    return (u >= P->p) ? u - P->p : u;
 }
 
-// Integer modulo: returns remainder string
-char* modDigits(const char* a, const char* b) {
-    if (strcmp(b, "0") == 0) {
-        fprintf(stderr, "Modulo by zero!\n");
-        return strdup("0");
+// Root table in Montgomery form: rt[h + j] = w^j where w is a primitive
+// 2h-th root of unity, for every power of two h < L
+static void nttRoots(uint32_t* rt, int L, const NttPrime* P) {
+    for (int h = 1; h < L; h *= 2) {
+        uint32_t w = montMul(powMod(P->g, (P->p - 1) / (2*h), P->p), P->r2, P);
+        rt[h] = montMul(1, P->r2, P);
+        for (int j = 1; j < h; j++) rt[h+j] = montMul(rt[h+j-1], w, P);
     }
+}
 
-    char* prefix = calloc(2,1); prefix[0] = '\0';
-
-    for (int i=0; a[i]; i++) {
-        // bring down next digit
-        int plen = strlen(prefix);
-        char* tmp = calloc(plen+2,1);
-        strcpy(tmp,prefix);
-        tmp[plen] = a[i]; tmp[plen+1] = '\0';
-        free(prefix);
-        prefix = stripLeadingZeros(tmp);
-
-        // subtract divisor until remainder < b
-        while (compareDigits(prefix, b) >= 0) {
-            char* t = subDigits(prefix, b);
-            free(prefix);
-            prefix = t;
+// Forward transform (decimation in frequency), natural in, bit-reversed out
+static void nttForward(uint32_t* a, int L, const uint32_t* rt, const NttPrime* P) {
+    uint32_t p = P->p;
+    for (int h = L/2; h >= 1; h /= 2) {
+        for (int s = 0; s < L; s += 2*h) {
+            for (int j = 0; j < h; j++) {
+                uint32_t u = a[s+j], v = a[s+j+h];
+                uint32_t sum = u + v;
+                a[s+j] = (sum >= p) ? sum - p : sum;
+                a[s+j+h] = montMul(u >= v ? u - v : u + p - v, rt[h+j], P);
+            }
         }
     }
+}
 
-    // if remainder empty, it's zero
-    if (*prefix == '\0') {
-        free(prefix);
-        return strdup("0");
+// Inverse transform (decimation in time), bit-reversed in, natural out, unscaled
+static void nttInverse(uint32_t* a, int L, const uint32_t* rt, const NttPrime* P) {
+    uint32_t p = P->p;
+    for (int h = 1; h < L; h *= 2) {
+        for (int s = 0; s < L; s += 2*h) {
+            uint32_t u = a[s], v = a[s+h];
+            uint32_t sum = u + v;
+            a[s] = (sum >= p) ? sum - p : sum;
+            a[s+h] = u >= v ? u - v : u + p - v;
+            for (int j = 1; j < h; j++) {
+                // w^-j = -w^(h-j)
+                u = a[s+j];
+                v = montMul(a[s+j+h], p - rt[2*h-j], P);
+                sum = u + v;
+                a[s+j] = (sum >= p) ? sum - p : sum;
+                a[s+j+h] = u >= v ? u - v : u + p - v;
+            }
+        }
     }
+}
 
-    return prefix; // remainder
+// Transform length for an la x lb product
+static int nttLength(int la, int lb) {
+    int L = 1;
+    while (L < la + lb - 1) L *= 2;
+    return L;
 }
 
-// BigFloat multiplication
-BigFloat mulBigFloat(BigFloat a, BigFloat b) {
-    BigFloat res;
-    res.sign = a.sign * b.sign;
-    res.scale = a.scale + b.scale;
-    res.digits = mulDigits(a.digits, b.digits);
+// Scratch limbs needed by limbsMulNtt
+static int nttScratch(int la, int lb) {
+    return 9 * nttLength(la, lb);
+}
+
+// Cyclic convolution of a and b modulo one prime; the result is left in fa
+// Reduce the first n limbs of a mod p into L transform slots and transform
+static void nttLoad(uint32_t* f, int L, const limb_t* a, int n, const uint32_t* rt, const NttPrime* P) {
+    for (int i = 0; i < n; i++) f[i] = a[i] % P->p;
+    memset(f + n, 0, (L - n) * sizeof(uint32_t));
+    nttForward(f, L, rt, P);
+}
+
+// One prime's convolution, also the unit of work for the thread pool
+typedef struct {
+    uint32_t* fa;
+    uint32_t* fb;
+    uint32_t* rt;
+    int L;
+    const limb_t* a;
+    int la;
+    const limb_t* b;
+    int lb;
+    NttPrime P;
+} NttTask;
+
+static void nttLoadTask(void* arg) {
+    NttTask* t = arg;
+    nttLoad(t->fb, t->L, t->b, t->lb, t->rt, &t->P);
+}
+
+static void nttConvolve(void* arg) {
+    NttTask* t = arg;
+    const NttPrime* P = &t->P;
+    uint32_t* fa = t->fa;
+    uint32_t* fb = t->fb;
+    int L = t->L;
+    nttRoots(t->rt, L, P);
 
-    // special case: result is "0"
-    if (strcmp(res.digits, "0") == 0) {
-        res.sign = 1;
-        res.scale = 0;
+    if (fb && mulParallel(t->lb)) {
+        // the second operand's transform on another thread
+        TaskGroup group = { 0 };
+        threadPoolSpawn(mulPool, &group, nttLoadTask, t);
+        nttLoad(fa, L, t->a, t->la, t->rt, P);
+        threadPoolWait(mulPool, &group);
+    } else {
+        nttLoad(fa, L, t->a, t->la, t->rt, P);
+        if (fb) nttLoad(fb, L, t->b, t->lb, t->rt, P);
+        else fb = fa;   // squaring shares the single transform
     }
 
-    return res;
+    // pointwise product, folding in the 1/L scaling and the Montgomery factors
+    uint32_t scale = montMul(montMul(powMod(L, P->p - 2, P->p), P->r2, P), P->r2, P);
+    for (int i = 0; i < L; i++) fa[i] = montMul(montMul(fa[i], fb[i], P), scale, P);
+
+    nttInverse(fa, L, t->rt, P);
 }
 
-BigFloat divBigFloat(BigFloat a, BigFloat b, int precision) {
-    BigFloat res;
+// Product of la x lb limbs into r (la+lb limbs) with a three prime NTT
+// scratch holds nttScratch(la, lb) limbs
+static void limbsMulNtt(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb, limb_t* scratch) {
+    int L = nttLength(la, lb);
+    int square = (a == b && la == lb);
+    uint32_t* res[3];
+    NttTask tasks[3];
 
-    if (strcmp(b.digits, "0") == 0) {
-        fprintf(stderr, "Division by zero!\n");
-        res.digits = strdup("0");
-        res.sign = 1;
-        res.scale = 0;
-        return res;
+    for (int i = 0; i < 3; i++) {
+        NttTask* t = &tasks[i];
+        t->fa = scratch + 3*i*L;
+        t->fb = square ? NULL : t->fa + L;
+        t->rt = t->fa + 2*L;
+        t->L = L;
+        t->a = a;
+        t->la = la;
+        t->b = b;
+        t->lb = lb;
+        t->P = nttPrime(i);
+        res[i] = t->fa;
+    }
+
+    // the three primes are independent
+    if (mulParallel(lb)) {
+        TaskGroup group = { 0 };
+        threadPoolSpawn(mulPool, &group, nttConvolve, &tasks[1]);
+        threadPoolSpawn(mulPool, &group, nttConvolve, &tasks[2]);
+        nttConvolve(&tasks[0]);
+        threadPoolWait(mulPool, &group);
+    } else {
+        for (int i = 0; i < 3; i++) nttConvolve(&tasks[i]);
+    }
+
+    // Garner recombination: x = r0 + p0*t1 + p0*p1*t2, carried in base 10^9
+    uint64_t p0 = nttModuli[0], p1 = nttModuli[1], p2 = nttModuli[2];
+    uint64_t p01 = p0 * p1;
+    uint64_t inv01 = powMod(p0 % p1, p1 - 2, p1);
+    uint64_t inv012 = powMod(p01 % p2, p2 - 2, p2);
+    uint64_t p01Lo = p01 % AAL_LIMB_BASE, p01Hi = p01 / AAL_LIMB_BASE;
+    uint64_t carry = 0;
+    int n = la + lb;
+
+    for (int i = 0; i < n; i++) {
+        uint64_t lo = 0, hi = 0;
+        if (i < la + lb - 1) {
+            uint64_t r0 = res[0][i], r1 = res[1][i], r2 = res[2][i];
+            uint64_t t1 = (r1 + p1 - r0 % p1) % p1 * inv01 % p1;
+            uint64_t x01 = r0 + p0 * t1;
+            uint64_t t2 = (r2 + p2 - x01 % p2) % p2 * inv012 % p2;
+
+            // x = x01 + p01*t2 split as lo + hi*10^9
+            lo = x01 % AAL_LIMB_BASE + t2 * p01Lo;
+            hi = x01 / AAL_LIMB_BASE + t2 * p01Hi;
+        }
+        uint64_t sum = lo + carry;
+        r[i] = (limb_t)(sum % AAL_LIMB_BASE);
+        carry = sum / AAL_LIMB_BASE + hi;
     }
+}
 
-    // Result sign
-    res.sign = a.sign * b.sign;
 
-    // Effective dividend and divisor are integers
-    // Align by shifting decimals: multiply dividend by 10^precision
-    int shift = precision + b.scale - a.scale;
+// Tier limbsMulN uses for n limb operands
+static AALMulTier mulNTier(int n) {
+    if (n <= cutoffs.karatsuba) return AAL_MUL_SCHOOLBOOK;
+    if (n < cutoffs.toom3) return AAL_MUL_KARATSUBA;
+    if (n < cutoffs.toom4) return AAL_MUL_TOOM3;
+    if (n < cutoffs.ntt || 2*n > NTT_MAX_LEN) return AAL_MUL_TOOM4;
+    return AAL_MUL_NTT;
+}
 
-    char* dividend = strdup(a.digits);
-    for (int i=0; i<shift; i++) {
-        char* tmp = calloc(strlen(dividend)+2,1);
-        strcpy(tmp, dividend);
-        strcat(tmp, "0");
-        free(dividend);
-        dividend = tmp;
+// Scratch limbs needed to multiply two n limb operands with a given top tier
+static int mulTierScratch(int n, AALMulTier tier) {
+    switch (tier) {
+        case AAL_MUL_KARATSUBA: {
+            int half = (n+1)/2;
+            return 4*half + 2 + mulNScratch(half);
+        }
+        case AAL_MUL_TOOM3: {
+            int k = (n+2)/3;
+            return 6*(k+2) + 3*(2*k+4) + mulNScratch(k+1);
+        }
+        case AAL_MUL_TOOM4: {
+            int k = (n+3)/4;
+            return 12*(k+2) + 6*(2*k+4) + mulNScratch(k+1);
+        }
+        case AAL_MUL_NTT:
+            return nttScratch(n, n);
+        default:
+            return 0;
     }
+}
+
+// Scratch limbs needed by limbsMulN for n limb operands
+static int mulNScratch(int n) {
+    return mulTierScratch(n, mulNTier(n));
+}
 
-    char* divisor = strdup(b.digits);
+// Karatsuba multiplication of two n limb operands, recursive
+// r holds 2n limbs; scratch holds mulNScratch(n) limbs and is the only
+// working memory used, so the recursion never allocates
+static void limbsMulKaratsuba(limb_t* r, const limb_t* x, const limb_t* y, int n, limb_t* scratch) {
+    // x = X1*B^half + X0, with X1 no longer than X0
+    STATS_DEPTH_IN();
+    int half = (n+1)/2;
+    int high = n - half;
 
-    // perform integer division
-    char* q = divDigits(dividend, divisor, 0);
+    // D = (X0 - X1)(Y1 - Y0), so that Z1 = Z0 + Z2 + D
+    limb_t* dx = scratch;
+    limb_t* dy = scratch + half;
+    limb_t* D = scratch + 2*half + 1;
+    int sign = limbsSubAbs(dx, x, half, x + half, high);
+    if (x == y) {
+        // squaring: D = -(X0 - X1)^2
+        dy = dx;
+        sign = -1;
+    } else {
+        sign *= -limbsSubAbs(dy, y, half, y + half, high);
+    }
 
-    res.digits = q;
-    res.scale = precision;
+    // D, with Z0 and Z2 straight into the low and high parts of r
+    MulTask products[3] = {
+        { D, dx, dy, half },
+        { r, x, y, half },
+        { r + 2*half, x + half, y + half, high }
+    };
+    limbsMulBatch(products, 3, half, D + 2*half + 1);
 
-    // normalize if result is zero
-    if (strcmp(res.digits, "0") == 0) {
-        res.sign = 1;
-        res.scale = 0;
+    // Z1 = Z0 + Z2 + D, built over the dx/dy area which is free again
+    limb_t* Z1 = scratch;
+    Z1[2*half] = limbsAdd(Z1, r, 2*half, r + 2*half, 2*high);
+    if (sign > 0) {
+        limbsAdd(Z1, Z1, 2*half+1, D, 2*half);
+    } else {
+        limbsSub(Z1, Z1, 2*half+1, D, 2*half);
     }
 
-    free(dividend);
-    free(divisor);
+    // result = Z2*B^(2*half) + Z1*B^half + Z0, added in place at offset half
+    limbsAdd(r + half, r + half, 2*n - half, Z1, limbsNormLen(Z1, 2*half+1));
+    STATS_DEPTH_OUT();
+}
 
-    return res;
+// Toom-3 evaluation of a = a0 + a1*X + a2*X^2 at 1, -1 and -2
+static void toom3Evaluate(SignedLimbs* v, const limb_t* a, int n, int k) {
+    SignedLimbs a0 = signedView(a, k);
+    SignedLimbs a1 = signedView(a + k, k);
+    SignedLimbs a2 = signedView(a + 2*k, n - 2*k);
+
+    // v[0] = a(1), v[1] = a(-1), v[2] = a(-2) = 2*(a(-1) + a2) - a0
+    signedAdd(&v[2], a0, a2, 1);
+    signedAdd(&v[0], v[2], a1, 1);
+    signedAdd(&v[1], v[2], a1, -1);
+    signedAdd(&v[2], v[1], a2, 1);
+    signedMul1(&v[2], v[2], 2);
+    signedAdd(&v[2], v[2], a0, -1);
+
+    for (int i = 0; i < 3; i++) signedPad(&v[i], k+1);
 }
 
-BigFloat modBigFloat(BigFloat a, BigFloat b) {
-    BigFloat res;
+// Toom-3 multiplication (points 0, 1, -1, -2, inf) of two n limb operands
+static void limbsMulToom3(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t* scratch) {
+    int k = (n+2)/3;
+    int square = (a == b);
+    SignedLimbs ea[3], eb[3], v[3];
 
-    if (strcmp(b.digits, "0") == 0) {
-        fprintf(stderr, "Modulo by zero!\n");
-        res.digits = strdup("0");
-        res.sign = 1;
-        res.scale = 0;
-        return res;
+    // carve the evaluations and point products out of scratch
+    limb_t* p = scratch;
+    for (int i = 0; i < 3; i++) {
+        ea[i].p = p; p += k+2;
+        eb[i].p = p; p += k+2;
+    }
+    for (int i = 0; i < 3; i++) {
+        v[i].p = p; p += 2*k+4;
+    }
+
+    toom3Evaluate(ea, a, n, k);
+    if (!square) toom3Evaluate(eb, b, n, k);
+
+    // point products: v0 and vinf straight into r, the rest into scratch
+    MulTask products[5] = {
+        { r, a, b, k },
+        { r + 4*k, a + 2*k, b + 2*k, n - 2*k }
+    };
+    for (int i = 0; i < 3; i++) {
+        const SignedLimbs* y = square ? &ea[i] : &eb[i];
+        MulTask t = { v[i].p, ea[i].p, y->p, k+1 };
+        products[2 + i] = t;
     }
+    limbsMulBatch(products, 5, k+1, p);
+    for (int i = 0; i < 3; i++) {
+        const SignedLimbs* y = square ? &ea[i] : &eb[i];
+        v[i].n = limbsNormLen(v[i].p, 2*k+2);
+        v[i].sign = (v[i].n && ea[i].sign != y->sign) ? -1 : 1;
+    }
+
+    // interpolation (Bodrato's sequence)
+    SignedLimbs c0 = signedView(r, 2*k);
+    SignedLimbs c4 = signedView(r + 4*k, 2*(n - 2*k));
+    SignedLimbs *r1 = &v[0], *r2 = &v[1], *r3 = &v[2];
+    signedAdd(r3, *r3, *r1, -1);
+    signedDivExact(r3, 3);
+    signedAdd(r1, *r1, *r2, -1);
+    signedDivExact(r1, 2);
+    signedAdd(r2, *r2, c0, -1);
+    signedAdd(r3, *r2, *r3, -1);
+    signedDivExact(r3, 2);
+    signedAdd(r3, *r3, c4, 1);
+    signedAdd(r3, *r3, c4, 1);
+    signedAdd(r2, *r2, *r1, 1);
+    signedAdd(r2, *r2, c4, -1);
+    signedAdd(r1, *r1, *r3, -1);
+
+    // recomposition: the middle coefficients are added at their offsets
+    memset(r + 2*k, 0, 2*k * sizeof(limb_t));
+    limbsAdd(r + k, r + k, 2*n - k, r1->p, r1->n);
+    limbsAdd(r + 2*k, r + 2*k, 2*n - 2*k, r2->p, r2->n);
+    limbsAdd(r + 3*k, r + 3*k, 2*n - 3*k, r3->p, r3->n);
+}
+
+// Toom-4 evaluation of a = a0 + a1*X + a2*X^2 + a3*X^3 at 1, -1, 2, -2 and 3
+static void toom4Evaluate(SignedLimbs* v, SignedLimbs* t, const limb_t* a, int n, int k) {
+    SignedLimbs a0 = signedView(a, k);
+    SignedLimbs a1 = signedView(a + k, k);
+    SignedLimbs a2 = signedView(a + 2*k, k);
+    SignedLimbs a3 = signedView(a + 3*k, n - 3*k);
+
+    // a(+-1) = (a0 + a2) +- (a1 + a3)
+    signedAdd(&t[0], a0, a2, 1);
+    signedAdd(&t[1], a1, a3, 1);
+    signedAdd(&v[0], t[0], t[1], 1);
+    signedAdd(&v[1], t[0], t[1], -1);
+
+    // a(+-2) = (a0 + 4*a2) +- 2*(a1 + 4*a3)
+    signedMul1(&t[0], a2, 4);
+    signedAdd(&t[0], t[0], a0, 1);
+    signedMul1(&t[1], a3, 4);
+    signedAdd(&t[1], t[1], a1, 1);
+    signedMul1(&t[1], t[1], 2);
+    signedAdd(&v[2], t[0], t[1], 1);
+    signedAdd(&v[3], t[0], t[1], -1);
+
+    // a(3) = ((3*a3 + a2)*3 + a1)*3 + a0
+    signedMul1(&v[4], a3, 3);
+    signedAdd(&v[4], v[4], a2, 1);
+    signedMul1(&v[4], v[4], 3);
+    signedAdd(&v[4], v[4], a1, 1);
+    signedMul1(&v[4], v[4], 3);
+    signedAdd(&v[4], v[4], a0, 1);
 
-    // Align by making both integers
-    int maxScale = (a.scale > b.scale ? a.scale : b.scale);
+    for (int i = 0; i < 5; i++) signedPad(&v[i], k+1);
+}
+
+// Toom-4 multiplication (points 0, 1, -1, 2, -2, 3, inf) of two n limb operands
+static void limbsMulToom4(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t* scratch) {
+    int k = (n+3)/4;
+    int square = (a == b);
+    SignedLimbs ea[5], eb[5], t[2], v[5], T;
 
-    // scale up a
-    char* da = strdup(a.digits);
-    for (int i=0; i < maxScale - a.scale; i++) {
-        char* tmp = calloc(strlen(da)+2,1);
-        strcpy(tmp, da);
-        strcat(tmp, "0");
-        free(da);
-        da = tmp;
+    // carve the evaluations, temporaries and point products out of scratch
+    limb_t* p = scratch;
+    for (int i = 0; i < 5; i++) {
+        ea[i].p = p; p += k+2;
+        eb[i].p = p; p += k+2;
     }
+    t[0].p = p; p += k+2;
+    t[1].p = p; p += k+2;
+    for (int i = 0; i < 5; i++) {
+        v[i].p = p; p += 2*k+4;
+    }
+    T.p = p; p += 2*k+4;
+
+    toom4Evaluate(ea, t, a, n, k);
+    if (!square) toom4Evaluate(eb, t, b, n, k);
 
-    // scale up b
-    char* db = strdup(b.digits);
-    for (int i=0; i < maxScale - b.scale; i++) {
-        char* tmp = calloc(strlen(db)+2,1);
-        strcpy(tmp, db);
-        strcat(tmp, "0");
-        free(db);
-        db = tmp;
+    // point products: v0 and vinf straight into r, the rest into scratch
+    MulTask products[7] = {
+        { r, a, b, k },
+        { r + 6*k, a + 3*k, b + 3*k, n - 3*k }
+    };
+    for (int i = 0; i < 5; i++) {
+        const SignedLimbs* y = square ? &ea[i] : &eb[i];
+        MulTask t = { v[i].p, ea[i].p, y->p, k+1 };
+        products[2 + i] = t;
     }
+    limbsMulBatch(products, 7, k+1, p);
+    for (int i = 0; i < 5; i++) {
+        const SignedLimbs* y = square ? &ea[i] : &eb[i];
+        v[i].n = limbsNormLen(v[i].p, 2*k+2);
+        v[i].sign = (v[i].n && ea[i].sign != y->sign) ? -1 : 1;
+    }
+
+    // interpolation: split the +-1 and +-2 values into even and odd parts
+    SignedLimbs c0 = signedView(r, 2*k);
+    SignedLimbs c6 = signedView(r + 6*k, 2*(n - 3*k));
+    SignedLimbs swap;
+    signedAdd(&T, v[0], v[1], -1);
+    signedAdd(&v[0], v[0], v[1], 1);
+    swap = v[1]; v[1] = T; T = swap;
+    signedDivExact(&v[0], 2);                   // E1 = c0 + c2 + c4 + c6
+    signedDivExact(&v[1], 2);                   // O1 = c1 + c3 + c5
+    signedAdd(&T, v[2], v[3], -1);
+    signedAdd(&v[2], v[2], v[3], 1);
+    swap = v[3]; v[3] = T; T = swap;
+    signedDivExact(&v[2], 2);                   // E2 = c0 + 4c2 + 16c4 + 64c6
+    signedDivExact(&v[3], 4);                   // O2 = c1 + 4c3 + 16c5
 
-    // compute remainder
-    char* rem = modDigits(da, db);
+    // even coefficients c2 and c4
+    signedAdd(&v[0], v[0], c0, -1);
+    signedAdd(&v[0], v[0], c6, -1);             // A = c2 + c4
+    signedAdd(&v[2], v[2], c0, -1);
+    signedMul1(&T, c6, 64);
+    signedAdd(&v[2], v[2], T, -1);              // B = 4c2 + 16c4
+    signedMul1(&T, v[0], 4);
+    signedAdd(&v[2], v[2], T, -1);
+    signedDivExact(&v[2], 12);                  // c4 = (B - 4A) / 12
+    signedAdd(&v[0], v[0], v[2], -1);           // c2 = A - c4
 
-    res.digits = rem;
-    res.scale = maxScale;
-    res.sign = a.sign; // remainder takes dividend's sign
+    // odd coefficients from O1, O2 and O3 = c1 + 9c3 + 81c5
+    signedAdd(&v[4], v[4], c0, -1);
+    signedMul1(&T, v[0], 9);
+    signedAdd(&v[4], v[4], T, -1);
+    signedMul1(&T, v[2], 81);
+    signedAdd(&v[4], v[4], T, -1);
+    signedMul1(&T, c6, 729);
+    signedAdd(&v[4], v[4], T, -1);
+    signedDivExact(&v[4], 3);                   // O3
+    signedAdd(&v[4], v[4], v[3], -1);
+    signedDivExact(&v[4], 5);                   // Y = c3 + 13c5
+    signedAdd(&v[3], v[3], v[1], -1);
+    signedDivExact(&v[3], 3);                   // X = c3 + 5c5
+    signedAdd(&v[4], v[4], v[3], -1);
+    signedDivExact(&v[4], 8);                   // c5 = (Y - X) / 8
+    signedMul1(&T, v[4], 5);
+    signedAdd(&v[3], v[3], T, -1);              // c3 = X - 5c5
+    signedAdd(&v[1], v[1], v[3], -1);
+    signedAdd(&v[1], v[1], v[4], -1);           // c1 = O1 - c3 - c5
 
-    // normalize zero
-    if (strcmp(res.digits, "0") == 0) {
-        res.sign = 1;
-        res.scale = 0;
+    // recomposition: the middle coefficients are added at their offsets
+    const SignedLimbs* c[6] = { NULL, &v[1], &v[0], &v[3], &v[2], &v[4] };
+    memset(r + 2*k, 0, 4*k * sizeof(limb_t));
+    for (int i = 1; i <= 5; i++) {
+        limbsAdd(r + i*k, r + i*k, 2*n - i*k, c[i]->p, c[i]->n);
     }
+}
 
-    free(da);
-    free(db);
+// Product of two n limb operands into r (2n limbs) with a given top tier,
+// subproducts pick their own tier
+// Passing the same pointer for a and b selects the squaring variants
+static void limbsMulTier(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t* scratch, AALMulTier tier) {
+    STATS_COUNT(mulTiers[tier == AAL_MUL_AUTO ? AAL_MUL_SCHOOLBOOK : tier]);
+    switch (tier) {
+        case AAL_MUL_KARATSUBA:
+            limbsMulKaratsuba(r, a, b, n, scratch);
+            break;
+        case AAL_MUL_TOOM3:
+            limbsMulToom3(r, a, b, n, scratch);
+            break;
+        case AAL_MUL_TOOM4:
+            limbsMulToom4(r, a, b, n, scratch);
+            break;
+        case AAL_MUL_NTT:
+            limbsMulNtt(r, a, n, b, n, scratch);
+            break;
+        default:
+            if (a == b) limbsSqrBase(r, a, n);
+            else limbsMulBase(r, a, n, b, n);
+            break;
+    }
+}
+
+// Product of two n limb operands into r (2n limbs), picking the tier by size
+static void limbsMulN(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t* scratch) {
+    limbsMulTier(r, a, b, n, scratch, mulNTier(n));
+}
+
+// Scratch limbs needed by limbsMulScratch for la x lb operands (la >= lb)
+static int mulScratch(int la, int lb) {
+    if (lb <= cutoffs.karatsuba) return 0;
+    if (la == lb) return mulNScratch(la);
+    if (lb >= cutoffs.ntt && la + lb <= NTT_MAX_LEN) return nttScratch(la, lb);
+
+    // a product slice plus whatever the slice products need
+    int need = mulNScratch(lb);
+    int rest = la % lb;
+    if (rest > 0) {
+        int tail = mulScratch(lb, rest);
+        if (tail > need) need = tail;
+    }
+    return 2*lb + need;
+}
+
+// Product of la x lb limbs into r (la+lb limbs) using caller provided scratch
+static void limbsMulScratch(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb, limb_t* scratch) {
+    if (la < lb) {
+        const limb_t* t = a; a = b; b = t;
+        int tl = la; la = lb; lb = tl;
+    }
+    if (lb == 0) {
+        memset(r, 0, la * sizeof(limb_t));
+        return;
+    }
+    if (lb <= cutoffs.karatsuba) {
+        STATS_COUNT(mulTiers[AAL_MUL_SCHOOLBOOK]);
+        if (a == b && la == lb) limbsSqrBase(r, a, la);
+        else limbsMulBase(r, a, la, b, lb);
+        return;
+    }
+    if (la == lb) {
+        limbsMulN(r, a, b, la, scratch);
+        return;
+    }
+    if (lb >= cutoffs.ntt && la + lb <= NTT_MAX_LEN) {
+        // the transform handles unbalanced operands directly
+        STATS_COUNT(mulTiers[AAL_MUL_NTT]);
+        limbsMulNtt(r, a, la, b, lb, scratch);
+        return;
+    }
+
+    // unbalanced operands: multiply lb sized slices of a and accumulate
+    limb_t* tmp = scratch;
+    memset(r, 0, (la+lb) * sizeof(limb_t));
+    for (int i = 0; i < la; i += lb) {
+        int chunk = (la - i < lb) ? la - i : lb;
+        limbsMulScratch(tmp, a + i, chunk, b, lb, scratch + 2*lb);
+        limbsAdd(r + i, r + i, la + lb - i, tmp, chunk + lb);
+    }
+}
+
+// Product of la x lb limbs into r (la+lb limbs), r must not overlap the operands
+// Passing the same operand twice squares it, which every tier does faster
+static void limbsMul(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb) {
+    int need = (la >= lb) ? mulScratch(la, lb) : mulScratch(lb, la);
+    limb_t* scratch = need ? limbsAlloc(need) : NULL;
+    limbsMulScratch(r, a, la, b, lb, scratch);
+    limbsFree(scratch);
+}
+
+// Columns c and up of the la x lb product into la+lb-c limbs, exactly as
+// limbsMulHighBase does, for operands of any size (Mulders' short product).
+// Splitting both at h <= (c+1)/2 puts a0*b0 wholly below column c; a1*b1 is
+// a full product of the top 0.7 or so and the cross terms recurse as short
+// products. That beats a Karatsuba product; past the Toom-3 cutoff it does
+// not, and the full product is cut instead.
+static void limbsMulHigh(limb_t* r, const limb_t* a, int la, const limb_t* b, int lb, int c) {
+    if (la < lb) {
+        const limb_t* t = a; a = b; b = t;
+        int tl = la; la = lb; lb = tl;
+    }
+    int n = la + lb - c;
+    if (n <= 0) return;
+    if (c <= 0) {
+        limbsMul(r, a, la, b, lb);
+        return;
+    }
+    if (lb <= cutoffs.mulHigh) {
+        limbsMulHighBase(r, a, la, b, lb, c);
+        return;
+    }
+
+    if (lb > cutoffs.toom3) {
+        // Toom and NTT products cost too little more than their top half
+        limb_t* full = limbsAlloc(la + lb);
+        limbsMul(full, a, la, b, lb);
+        memcpy(r, full + c, n * sizeof(limb_t));
+        limbsFree(full);
+        return;
+    }
+
+    int h = 3 * lb / 10;
+    if (h > (c+1) / 2) h = (c+1) / 2;
+    if (h < 1) h = 1;
+    int sqr = (a == b && la == lb);
+    limb_t* tmp = limbsAlloc(n + 1);
+
+    // a1*b1 sits at column 2h, at most one past c
+    if (2*h >= c) {
+        memset(r, 0, (2*h - c) * sizeof(limb_t));
+        limbsMul(r + 2*h - c, a + h, la - h, b + h, lb - h);
+    } else {
+        limbsMulHigh(r, a + h, la - h, b + h, lb - h, c - 2*h);
+    }
+
+    // a1*b0 and a0*b1 at column h, the same product twice when squaring
+    if (la + h > c) {
+        limbsMulHigh(tmp, a + h, la - h, b, h, c - h);
+        limbsAdd(r, r, n, tmp, la + h - c);
+    }
+    if (lb + h > c) {
+        if (!sqr) limbsMulHigh(tmp, a, h, b + h, lb - h, c - h);
+        limbsAdd(r, r, n, tmp, lb + h - c);
+    }
+    limbsFree(tmp);
+}
+
+// Long division (Knuth algorithm D): q = a / b and rem = a % b
+// q needs la-lb+1 limbs, rem needs lb limbs, either may be NULL
+// b must be normalized with lb > 0
+static void limbsDivRemBase(limb_t* q, limb_t* rem, const limb_t* a, int la, const limb_t* b, int lb) {
+    if (la < lb) {
+        if (q) q[0] = 0;
+        if (rem) {
+            memcpy(rem, a, la * sizeof(limb_t));
+            memset(rem + la, 0, (lb - la) * sizeof(limb_t));
+        }
+        return;
+    }
+
+    if (lb == 1) {
+        limb_t* quot = q ? q : limbsAlloc(la);
+        limb_t r = limbsDivRem1(quot, a, la, b[0]);
+        if (rem) rem[0] = r;
+        if (!q) limbsFree(quot);
+        return;
+    }
+
+    // normalize so the top divisor limb is at least half the base
+    limb_t d = AAL_LIMB_BASE / (b[lb-1] + 1);
+    limb_t* u = limbsAlloc(la+1);
+    limb_t* v = limbsAlloc(lb);
+    u[la] = limbsMul1(u, a, la, d);
+    limbsMul1(v, b, lb, d);
+
+    uint64_t vTop = v[lb-1], vNext = v[lb-2];
+    for (int j = la - lb; j >= 0; j--) {
+        // estimate the quotient limb from the top of the running remainder
+        uint64_t num = (uint64_t)u[j+lb] * AAL_LIMB_BASE + u[j+lb-1];
+        uint64_t qhat = num / vTop;
+        uint64_t rhat = num % vTop;
+        while (qhat >= AAL_LIMB_BASE ||
+               qhat * vNext > rhat * AAL_LIMB_BASE + u[j+lb-2]) {
+            qhat--;
+            rhat += vTop;
+            if (rhat >= AAL_LIMB_BASE) break;
+        }
+
+        // multiply and subtract
+        uint64_t carry = 0;
+        limb_t borrow = 0;
+        for (int i = 0; i < lb; i++) {
+            uint64_t p = qhat * v[i] + carry;
+            carry = p / AAL_LIMB_BASE;
+            limb_t sub = (limb_t)(p - carry * AAL_LIMB_BASE) + borrow;
+            borrow = (u[i+j] < sub);
+            u[i+j] = borrow ? u[i+j] + AAL_LIMB_BASE - sub : u[i+j] - sub;
+        }
+        uint64_t sub = carry + borrow;
+
+        if (u[j+lb] < sub) {
+            // estimate was one too large: add the divisor back
+            qhat--;
+            limbsAddN(u+j, u+j, v, lb);
+            u[j+lb] = 0;
+        } else {
+            u[j+lb] -= (limb_t)sub;
+        }
+        if (q) q[j] = (limb_t)qhat;
+    }
+
+    if (rem) limbsDivRem1(rem, u, lb, d);
+    limbsFree(u);
+    limbsFree(v);
+}
+
+static const limb_t limbOne[1] = { 1 };
+
+// ---------- Burnikel-Ziegler division ----------
+
+// Compare two magnitudes of the same fixed length n
+static int limbsCmpN(const limb_t* a, const limb_t* b, int n) {
+    for (int i = n-1; i >= 0; i--) {
+        if (a[i] != b[i]) return (a[i] > b[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+static void bzDiv2n1n(limb_t* q, limb_t* r, const limb_t* a, const limb_t* b, int n);
+
+// 3h/2h step: a (3h limbs) / b (2h limbs) where a < b*B^h and b is normalized
+// q gets h limbs and r gets 2h limbs
+static void bzDiv3n2n(limb_t* q, limb_t* r, const limb_t* a, const limb_t* b, int h) {
+    const limb_t* a1 = a + 2*h;
+    const limb_t* b1 = b + h;
+
+    // x = R1*B^h + A3 where R1 is the remainder of the top two thirds by b1
+    limb_t* x = limbsAlloc(2*h+1);
+    memcpy(x, a, h * sizeof(limb_t));
+    if (limbsCmpN(a1, b1, h) < 0) {
+        bzDiv2n1n(q, x + h, a + h, b1, h);
+        x[2*h] = 0;
+    } else {
+        // a1 == b1 here: Q = B^h - 1 and R1 = [a1 a2] - Q*b1 = a2 + b1
+        for (int i = 0; i < h; i++) q[i] = AAL_LIMB_BASE - 1;
+        x[2*h] = limbsAddN(x + h, a + h, b1, h);
+    }
+
+    // R = x - Q*b2, adding b back while the subtraction left a borrow
+    limb_t* d = limbsAlloc(2*h);
+    limbsMul(d, q, h, b, h);
+    limb_t borrow = limbsSub(x, x, 2*h+1, d, limbsNormLen(d, 2*h));
+    while (borrow) {
+        limbsSub(q, q, h, limbOne, 1);
+        borrow -= limbsAdd(x, x, 2*h+1, b, 2*h);
+    }
+
+    memcpy(r, x, 2*h * sizeof(limb_t));
+    limbsFree(x);
+    limbsFree(d);
+}
+
+// 2n/1n step: a (2n limbs) / b (n limbs) where a < b*B^n and b is normalized
+// q gets n limbs and r gets n limbs
+static void bzDiv2n1n(limb_t* q, limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    if (n % 2 || n < cutoffs.bz) {
+        limb_t* qt = limbsAlloc(n+1);
+        limbsDivRemBase(qt, r, a, 2*n, b, n);
+        memcpy(q, qt, n * sizeof(limb_t));
+        limbsFree(qt);
+        return;
+    }
+
+    // a = [A1 A2 A3 A4] and b = [B1 B2] in halves of h limbs
+    int h = n/2;
+    limb_t* t = limbsAlloc(3*h);
+    bzDiv3n2n(q + h, t + h, a + h, b, h);
+    memcpy(t, a, h * sizeof(limb_t));
+    bzDiv3n2n(q, r, t, b, h);
+    limbsFree(t);
+}
+
+// Recursive division (Burnikel-Ziegler): q = a / b and rem = a % b
+// (either may be NULL); expects la >= lb and a normalized divisor
+static void limbsDivRemBZ(limb_t* q, limb_t* rem, const limb_t* a, int la, const limb_t* b, int lb) {
+    // block size n = m*2^k with m below the cutoff, so halving lands on base cases
+    int k = 0;
+    while (((lb + (1 << k) - 1) >> k) >= cutoffs.bz) k++;
+    int n = ((lb + (1 << k) - 1) >> k) << k;
+    int sigma = n - lb;
+
+    // scale both operands so the divisor fills n limbs with a top limb >= B/2
+    limb_t d = AAL_LIMB_BASE / (b[lb-1] + 1);
+    limb_t* bn = limbsAlloc(n);
+    memset(bn, 0, sigma * sizeof(limb_t));
+    limbsMul1(bn + sigma, b, lb, d);
+
+    // split the dividend into t blocks of n limbs, keeping the top block below B^n/2
+    int t = (la + sigma + 1) / n + 1;
+    if (t < 2) t = 2;
+    limb_t* an = limbsAlloc(t*n);
+    memset(an, 0, t*n * sizeof(limb_t));
+    an[sigma + la] = limbsMul1(an + sigma, a, la, d);
+
+    // long division with n limb digits, each step a 2n/1n division
+    limb_t* qb = limbsAlloc((t-1)*n);
+    limb_t* z = limbsAlloc(2*n);
+    limb_t* rb = limbsAlloc(n);
+    memcpy(z, an + (t-2)*n, 2*n * sizeof(limb_t));
+    for (int i = t-2; i >= 0; i--) {
+        bzDiv2n1n(qb + i*n, rb, z, bn, n);
+        if (i > 0) {
+            memcpy(z, an + (i-1)*n, n * sizeof(limb_t));
+            memcpy(z + n, rb, n * sizeof(limb_t));
+        }
+    }
+
+    // the quotient is unchanged by the scaling; the remainder is scaled back down
+    if (q) memcpy(q, qb, (la - lb + 1) * sizeof(limb_t));
+    if (rem) limbsDivRem1(rem, rb + sigma, lb, d);
+
+    limbsFree(bn); limbsFree(an); limbsFree(qb); limbsFree(z); limbsFree(rb);
+}
+
+// ---------- Newton division ----------
+
+static void limbsDivRem(limb_t* q, limb_t* rem, const limb_t* a, int la, const limb_t* b, int lb);
+
+// v = floor(B^(2n) / d) for an n limb divisor with a nonzero top limb
+// v holds n+2 limbs; returns the normalized length of v
+// Each level inverts the top h limbs, takes one Newton step
+// V1 = V0 + V0*(B^(2n) - d*V0)/B^(2n) on the fast multiplier and then
+// corrects V1 to the exact floor, so errors never build up across levels
+static int limbsInvert(limb_t* v, const limb_t* d, int n) {
+    if (n < cutoffs.newton || n < 8) {
+        limb_t* x = limbsAlloc(2*n+1);
+        memset(x, 0, 2*n * sizeof(limb_t));
+        x[2*n] = 1;
+        limbsDivRem(v, NULL, x, 2*n+1, d, n);
+        limbsFree(x);
+        return limbsNormLen(v, n+2);
+    }
+
+    // h limbs are enough for the step to land within a few units of the result
+    int h = (n+4)/2;
+    limb_t* vh = limbsAlloc(h+2);
+    int lh = limbsInvert(vh, d + n - h, h);
+
+    // with V0 = Vh*B^(n-h): B^(2n) - d*V0 = E*B^(n-h) where E = B^(n+h) - d*Vh
+    int cap = n + h + 3;
+    limb_t* pw = limbsAlloc(cap);
+    limb_t* dv = limbsAlloc(cap);
+    limb_t* ebuf = limbsAlloc(cap);
+    memset(pw, 0, (n+h) * sizeof(limb_t));
+    pw[n+h] = 1;
+    limbsMul(dv, d, n, vh, lh);
+    SignedLimbs E = { ebuf, 0, 1 };
+    signedAdd(&E, signedView(pw, n+h+1), signedView(dv, n+lh), -1);
+
+    // correction C = Vh*E / B^(2h)
+    limb_t* c = limbsAlloc(lh + E.n + 1);
+    limbsMul(c, vh, lh, E.p, E.n);
+    int lc = limbsNormLen(c, lh + E.n);
+
+    // V1 = Vh*B^(n-h) + C
+    memset(v, 0, (n+2) * sizeof(limb_t));
+    memcpy(v + n - h, vh, lh * sizeof(limb_t));
+    if (lc > 2*h) {
+        if (E.sign > 0) limbsAdd(v, v, n+2, c + 2*h, lc - 2*h);
+        else limbsSub(v, v, n+2, c + 2*h, lc - 2*h);
+    }
+    int lv = limbsNormLen(v, n+2);
+
+    // fix up to the exact floor: R = B^(2n) - d*V1 must satisfy 0 <= R < d
+    limb_t* pw2 = limbsAlloc(2*n+1);
+    limb_t* dv1 = limbsAlloc(n + lv);
+    limb_t* rbuf = limbsAlloc(2*n+3);
+    memset(pw2, 0, 2*n * sizeof(limb_t));
+    pw2[2*n] = 1;
+    limbsMul(dv1, d, n, v, lv);
+    SignedLimbs R = { rbuf, 0, 1 };
+    SignedLimbs D = signedView(d, n);
+    signedAdd(&R, signedView(pw2, 2*n+1), signedView(dv1, n + lv), -1);
+    while (R.sign < 0) {
+        limbsSub(v, v, n+2, limbOne, 1);
+        signedAdd(&R, R, D, 1);
+    }
+    while (limbsCmp(R.p, R.n, D.p, D.n) >= 0) {
+        limbsAdd(v, v, n+2, limbOne, 1);
+        signedAdd(&R, R, D, -1);
+    }
+
+    limbsFree(vh); limbsFree(pw); limbsFree(dv); limbsFree(ebuf); limbsFree(c);
+    limbsFree(pw2); limbsFree(dv1); limbsFree(rbuf);
+    return limbsNormLen(v, n+2);
+}
+
+// One division step of x (lx <= 2n limbs) by the n limb divisor b, using
+// v = floor(B^(2n) / b); writes the quotient (lx-n+1 limbs) to q and the
+// remainder (n limbs) to rem. prod holds 3n+3 limbs and r holds 2n+1
+static void newtonDivStep(limb_t* q, limb_t* rem, const limb_t* x, int lx, const limb_t* b, int n,
+                          const limb_t* v, int lv, limb_t* prod, limb_t* r) {
+    int qlen = lx - n + 1;
+    lx = limbsNormLen(x, lx);
+
+    // Q0 = floor(x*v / B^(2n)) is at most two below the true quotient
+    memset(q, 0, qlen * sizeof(limb_t));
+    limbsMul(prod, x, lx, v, lv);
+    int lq = limbsNormLen(prod, lx + lv) - 2*n;
+    if (lq > 0) memcpy(q, prod + 2*n, lq * sizeof(limb_t));
+    else lq = 0;
+
+    // R = x - Q0*b, then step Q0 up while R >= b
+    limbsMul(prod, b, n, q, lq);
+    int lp = limbsNormLen(prod, n + lq);
+    memcpy(r, x, lx * sizeof(limb_t));
+    limbsSub(r, r, lx, prod, lp);
+    int lr = limbsNormLen(r, lx);
+    while (limbsCmp(r, lr, b, n) >= 0) {
+        limbsSub(r, r, lr, b, n);
+        lr = limbsNormLen(r, lr);
+        limbsAdd(q, q, qlen, limbOne, 1);
+    }
+
+    memcpy(rem, r, lr * sizeof(limb_t));
+    memset(rem + lr, 0, (n - lr) * sizeof(limb_t));
+}
+
+// Division by Newton reciprocal: q = a / b and rem = a % b (either may be NULL)
+// Expects la >= n and a normalized n limb divisor
+static void limbsDivRemNewton(limb_t* q, limb_t* rem, const limb_t* a, int la, const limb_t* b, int n) {
+    int qlen = la - n + 1;
+
+    if (qlen + 1 < n) {
+        // short quotient: divide the top limbs only, which gives Q' with
+        // Q <= Q' <= Q + 2, then step down against the full divisor
+        int t = n - qlen - 1;
+        limb_t* qq = limbsAlloc(qlen);
+        limbsDivRem(qq, NULL, a + t, la - t, b + t, n - t);
+        int lq = limbsNormLen(qq, qlen);
+
+        limb_t* p = limbsAlloc(n + qlen);
+        limbsMul(p, b, n, qq, lq);
+        int lp = limbsNormLen(p, n + lq);
+        int na = limbsNormLen(a, la);
+        while (limbsCmp(p, lp, a, na) > 0) {
+            limbsSub(qq, qq, qlen, limbOne, 1);
+            limbsSub(p, p, lp, b, n);
+            lp = limbsNormLen(p, lp);
+        }
+
+        if (q) memcpy(q, qq, qlen * sizeof(limb_t));
+        if (rem) {
+            limbsSub(rem, a, n, p, lp < n ? lp : n);
+        }
+        limbsFree(qq);
+        limbsFree(p);
+        return;
+    }
+
+    limb_t* v = limbsAlloc(n+2);
+    int lv = limbsInvert(v, b, n);
+    limb_t* prod = limbsAlloc(3*n+3);
+    limb_t* r = limbsAlloc(2*n+1);
+    limb_t* x = limbsAlloc(2*n);
+    limb_t* qt = limbsAlloc(n+1);
+    limb_t* rm = limbsAlloc(n);
+
+    // top block of up to 2n limbs, then n limbs at a time like long division
+    int pos = (la > 2*n) ? la - 2*n : 0;
+    newtonDivStep(qt, rm, a + pos, la - pos, b, n, v, lv, prod, r);
+    if (q) memcpy(q + pos, qt, (la - pos - n + 1) * sizeof(limb_t));
+
+    while (pos > 0) {
+        int k = (pos < n) ? pos : n;
+        pos -= k;
+        memcpy(x, a + pos, k * sizeof(limb_t));
+        memcpy(x + k, rm, n * sizeof(limb_t));
+        newtonDivStep(qt, rm, x, n + k, b, n, v, lv, prod, r);
+        if (q) memcpy(q + pos, qt, k * sizeof(limb_t));
+    }
+
+    if (rem) memcpy(rem, rm, n * sizeof(limb_t));
+    limbsFree(v); limbsFree(prod); limbsFree(r); limbsFree(x); limbsFree(qt); limbsFree(rm);
+}
+
+// Division: q = a / b and rem = a % b (either may be NULL)
+// q needs la-lb+1 limbs, rem needs lb limbs; b must be normalized with lb > 0
+// Long division serves small divisors or short quotients, Burnikel-Ziegler
+// the mid range and Newton the rest
+static void limbsDivRem(limb_t* q, limb_t* rem, const limb_t* a, int la, const limb_t* b, int lb) {
+    int qlen = la - lb + 1;
+    if (lb < cutoffs.bz || qlen < cutoffs.bz) {
+        STATS_COUNT(divTiers[0]);
+        limbsDivRemBase(q, rem, a, la, b, lb);
+    } else if (lb < cutoffs.newton || qlen < cutoffs.newton) {
+        STATS_COUNT(divTiers[1]);
+        limbsDivRemBZ(q, rem, a, la, b, lb);
+    } else {
+        STATS_COUNT(divTiers[2]);
+        limbsDivRemNewton(q, rem, a, la, b, lb);
+    }
+}
+
+// ---------- Decimal conversion ----------
+
+// End of the run of decimal digits that starts at p. On x86-64 the bytes
+// are classified 16 at a time: c - '0' is a digit exactly when it is at
+// most 9 as an unsigned byte
+static const char* skipDigits(const char* p, const char* end) {
+#ifdef AAL_SIMD_X86
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    for (; end - p >= 16; p += 16) {
+        __m128i d = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)p), zero);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, nine), d));
+        if (mask != 0xFFFF) return p + __builtin_ctz(~mask);
+    }
+#endif
+    while (p < end && (unsigned char)(*p - '0') <= 9) p++;
+    return p;
+}
+
+// Value of the 8 digits at p, most significant first
+static inline limb_t eightDigits(const char* p) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // SWAR: merge neighbouring digits, then pairs of those, then quads
+    uint64_t v;
+    memcpy(&v, p, 8);
+    v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return (limb_t)(((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+#else
+    limb_t v = 0;
+    for (int i = 0; i < 8; i++) v = 10 * v + (limb_t)(p[i] - '0');
+    return v;
+#endif
+}
+
+// Pack the digits a[0..la) followed by f[0..lf) into limbs, with the last
+// digit shift (0 to 8) places up. Whole limbs lying in one of the two
+// runs are converted 8 digits at a time; only the lowest limb, the top one
+// and the one straddling the decimal point go digit by digit
+static int limbsFromDecimal(limb_t* out, const char* a, int la, const char* f, int lf, int shift) {
+    int n = la + lf;
+    int k = 0;
+    if (n == 0) return 0;
+
+#define DIGIT(i) ((limb_t)(((i) < la ? a[i] : f[(i) - la]) - '0'))
+    int take = (n < AAL_LIMB_DIGITS - shift) ? n : AAL_LIMB_DIGITS - shift;
+    limb_t cur = 0;
+    for (int i = n - take; i < n; i++) cur = 10 * cur + DIGIT(i);
+    out[k++] = cur * pow10Limb[shift];
+    n -= take;
+
+    for (; n >= AAL_LIMB_DIGITS; n -= AAL_LIMB_DIGITS) {
+        int i = n - AAL_LIMB_DIGITS;
+        const char* p = (i >= la) ? f + (i - la) : (n <= la) ? a + i : NULL;
+        if (p) {
+            out[k++] = (limb_t)(p[0] - '0') * 100000000 + eightDigits(p + 1);
+        } else {
+            for (cur = 0; i < n; i++) cur = 10 * cur + DIGIT(i);
+            out[k++] = cur;
+        }
+    }
+
+    if (n > 0) {
+        cur = 0;
+        for (int i = 0; i < n; i++) cur = 10 * cur + DIGIT(i);
+        out[k++] = cur;
+    }
+#undef DIGIT
+    return k;
+}
+
+// Two digit groups "00" to "99"
+static const char digitPairs[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+// The 9 digits of a limb, zero padded, two at a time
+static inline void limbToChars(char* out, limb_t v) {
+    limb_t hi = v / 10000, lo = v % 10000;
+    out[0] = (char)('0' + hi / 10000);
+    hi %= 10000;
+    memcpy(out + 1, digitPairs + 2 * (hi / 100), 2);
+    memcpy(out + 3, digitPairs + 2 * (hi % 100), 2);
+    memcpy(out + 5, digitPairs + 2 * (lo / 100), 2);
+    memcpy(out + 7, digitPairs + 2 * (lo % 100), 2);
+}
+
+// Write the top limb of a magnitude without its leading zeros
+static inline char* topLimbToChars(char* out, limb_t v) {
+    char digit[AAL_LIMB_DIGITS];
+    int width = limbDigits(v);
+    limbToChars(digit, v);
+    memcpy(out, digit + AAL_LIMB_DIGITS - width, width);
+    return out + width;
+}
+
+// Write the digits of a normalized magnitude, returns the end of the output
+static char* limbsToDecimal(char* out, const limb_t* a, int n) {
+    if (n == 0) {
+        *out++ = '0';
+        return out;
+    }
+    out = topLimbToChars(out, a[n-1]);
+    for (int i = n-2; i >= 0; i--) {
+        limbToChars(out, a[i]);
+        out += AAL_LIMB_DIGITS;
+    }
+    return out;
+}
+
+// Number of decimal digits of a normalized magnitude
+static int limbsDecimalLen(const limb_t* a, int n) {
+    if (n == 0) return 1;
+    return (n-1) * AAL_LIMB_DIGITS + limbDigits(a[n-1]);
+}
+
+// Where the significand of bf lives: the heap, or inline while it is small
+static inline limb_t* bigFloatLimbs(BigFloat* bf) {
+    return bf->limbs ? bf->limbs : bf->small;
+}
+
+// Move zero limbs at the bottom of bf into its exponent, normalizing zero
+// (bf->len must already leave out leading zero limbs)
+static void bigFloatCompact(BigFloat* bf) {
+    if (bf->len == 0) {
+        bf->exp = 0;
+        bf->sign = 1;
+        return;
+    }
+    limb_t* limbs = bigFloatLimbs(bf);
+    if (limbs[0] != 0) return;
+
+    int z = 1;
+    while (limbs[z] == 0) z++;
+    memmove(limbs, limbs + z, (bf->len - z) * sizeof(limb_t));
+    bf->len -= z;
+    bf->exp += z;
+}
+
+// Storage for a result of up to n limbs: the inline limbs of res when
+// they are enough, so small results never touch the heap
+static inline limb_t* resultLimbs(BigFloat* res, int n) {
+    res->limbs = (n > AAL_SMALL_LIMBS) ? limbsAlloc(n) : NULL;
+    res->cap = n;
+    return bigFloatLimbs(res);
+}
+
+// Finish a result of up to n limbs written to its storage
+static inline void settleBigFloat(BigFloat* bf, int n, int exp, int sign) {
+    limb_t* limbs = bigFloatLimbs(bf);
+    bf->len = limbsNormLen(limbs, n);
+    bf->exp = exp;
+    bf->sign = sign;
+
+    // normalize zero, and move zero limbs at the bottom into the exponent
+    if (bf->len == 0) {
+        bf->exp = 0;
+        bf->sign = 1;
+    } else if (limbs[0] == 0) {
+        bigFloatCompact(bf);
+    }
+}
+
+// Build a BigFloat from a limb buffer it takes ownership of
+static inline BigFloat makeBigFloat(limb_t* limbs, int len, int exp, int sign) {
+    BigFloat bf;
+    bf.limbs = limbs;
+    bf.cap = len;
+    settleBigFloat(&bf, len, exp, sign);
+    return bf;
+}
+
+// Scratch of n limbs: buf (2 * AAL_SMALL_LIMBS long) when it is enough,
+// else the heap
+static inline limb_t* scratchLimbs(limb_t* buf, int n) {
+    return (n <= 2 * AAL_SMALL_LIMBS) ? buf : limbsAlloc(n);
+}
+
+static inline void scratchFree(limb_t* p, const limb_t* buf) {
+    if (p != buf) limbsFree(p);
+}
+
+static BigFloat zeroBigFloat(void) {
+    BigFloat bf = { 0 };
+    bf.sign = 1;
+    return bf;
+}
+
+// Whole limbs covering digits >= 0 fractional digits, and the digits of
+// the last of them left over; from digits / 9 and % 9, so that digits up to
+// INT_MAX do not overflow
+static inline int digitLimbs(int digits) {
+    return digits / AAL_LIMB_DIGITS + (digits % AAL_LIMB_DIGITS != 0);
+}
+
+static inline int digitPad(int digits) {
+    return (AAL_LIMB_DIGITS - digits % AAL_LIMB_DIGITS) % AAL_LIMB_DIGITS;
+}
+
+// v / 10^scale for small non-negative integers v and scale
+static BigFloat smallBigFloat(uint64_t v, int scale) {
+    // scale rounded up to whole limbs, the difference taken up by v
+    int k = digitLimbs(scale);
+    BigFloat res;
+    limb_t* r = resultLimbs(&res, 4);
+    for (int i = 0; i < 3; i++) {
+        r[i] = (limb_t)(v % AAL_LIMB_BASE);
+        v /= AAL_LIMB_BASE;
+    }
+    r[3] = limbsMul1(r, r, 3, pow10Limb[digitPad(scale)]);
+    settleBigFloat(&res, 4, -k, 1);
+    return res;
+}
+
+// Parse exactly n characters at s into *bf; s need not be terminated.
+// Malformed numbers print an error, leave zero in *bf and return -1
+int readBigFloatN(const char* s, size_t n, BigFloat* bf) {
+    STATS_OP(AAL_STAT_PARSE, (int)(n / AAL_LIMB_DIGITS + 1));
+    const char* start = s;
+    *bf = zeroBigFloat();
+    const char* end = s + n;
+    int sign = 1;
+
+    // normalize sign: handle multiple +/-
+    while (s < end && (*s == '+' || *s == '-')) {
+        if (*s == '-') sign = -sign;
+        s++;
+    }
+
+    // integer digits, then the fraction digits after an optional point
+    const char* intEnd = skipDigits(s, end);
+    const char* frac = intEnd;
+    const char* fracEnd = intEnd;
+    if (intEnd < end && *intEnd == '.') {
+        frac = intEnd + 1;
+        fracEnd = skipDigits(frac, end);
+    }
+    size_t digits = (size_t)(intEnd - s) + (size_t)(fracEnd - frac);
+    const char* p = fracEnd;
+
+    // optional exponent as in 1.5e-7 or 1e500000
+    long long e10 = 0;
+    int bad = 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        int esign = 1;
+        if (++p < end && (*p == '+' || *p == '-')) {
+            if (*p == '-') esign = -1;
+            p++;
+        }
+        bad = (p == end);
+        for (; p < end && isdigit((unsigned char)*p); p++) {
+            if (e10 <= INT_MAX) e10 = 10 * e10 + (*p - '0');
+        }
+        e10 *= esign;
+    }
+
+    if (bad || digits == 0 || p != end || digits > (size_t)INT_MAX - AAL_LIMB_DIGITS ||
+        e10 > INT_MAX || e10 < -INT_MAX) {
+        // keep the message readable for huge operands
+        int shown = n > 64 ? 64 : (int)n;
+        fprintf(stderr, "Invalid number format: %.*s%s\n", shown, start, n > 64 ? "..." : "");
+        return -1;
+    }
+
+    // value = digits * 10^e10; the exponent takes whole limbs of it and the
+    // digits are packed shifted up by the rest
+    e10 -= fracEnd - frac;
+    int exp = (e10 >= 0) ? (int)(e10 / AAL_LIMB_DIGITS) : -(int)((-e10 + AAL_LIMB_DIGITS - 1) / AAL_LIMB_DIGITS);
+    int shift = (int)(e10 - (long long)AAL_LIMB_DIGITS * exp);
+    BigFloat res;
+    limb_t* limbs = resultLimbs(&res, (int)((digits + shift + AAL_LIMB_DIGITS - 1) / AAL_LIMB_DIGITS));
+    settleBigFloat(&res, limbsFromDecimal(limbs, s, (int)(intEnd - s), frac, (int)(fracEnd - frac), shift), exp, sign);
+    *bf = res;
+    return 0;
+}
+
+// readBigFloatN for callers that take zero for a malformed number
+BigFloat parseBigFloatN(const char* s, size_t n) {
+    BigFloat res;
+    readBigFloatN(s, n, &res);
+    return res;
+}
+
+// Parse string into BigFloat
+BigFloat parseBigFloat(const char* s) {
+    return parseBigFloatN(s, strlen(s));
+}
+
+// Where formatted text goes: straight into a buffer known to be large
+// enough, or through buf to a stream, flushed when a piece would not fit
+typedef struct {
+    char* p;
+    char* end;
+    char* buf;
+    FILE* f;
+    int failed;
+} TextSink;
+
+// Make room for n more bytes (no more than buf holds)
+static inline void sinkRoom(TextSink* s, size_t n) {
+    if (s->f && (size_t)(s->end - s->p) < n) {
+        size_t fill = s->p - s->buf;
+        if (fwrite(s->buf, 1, fill, s->f) != fill) s->failed = 1;
+        s->p = s->buf;
+    }
+}
+
+static void sinkZeros(TextSink* s, size_t n) {
+    while (n > 0) {
+        size_t run = n;
+        if (s->f) {
+            sinkRoom(s, 1);
+            if (run > (size_t)(s->end - s->p)) run = s->end - s->p;
+        }
+        memset(s->p, '0', run);
+        s->p += run;
+        n -= run;
+    }
+}
+
+// Trailing zero digits of a nonzero limb
+static int limbTrailingZeros(limb_t v) {
+    int z = 0;
+    for (; v % 10 == 0; v /= 10) z++;
+    return z;
+}
+
+// Lay out bf as text. The point of a fraction always falls between two
+// limbs, so every limb is written whole except the top one (no leading
+// zeros) and, after a point, the lowest one (no trailing zeros)
+static void formatText(TextSink* s, BigFloat bf) {
+    STATS_OP(AAL_STAT_FORMAT, bf.len);
+    const limb_t* limbs = bigFloatLimbs(&bf);
+    int f = (bf.exp < 0) ? -bf.exp : 0;     // fractional limbs
+
+    sinkRoom(s, 1 + AAL_LIMB_DIGITS);
+    if (bf.len == 0) {
+        *s->p++ = '0';
+        return;
+    }
+    if (bf.sign < 0) *s->p++ = '-';
+
+    if (bf.len > f) {
+        s->p = topLimbToChars(s->p, limbs[bf.len-1]);
+        for (int i = bf.len-2; i >= f; i--) {
+            sinkRoom(s, AAL_LIMB_DIGITS);
+            limbToChars(s->p, limbs[i]);
+            s->p += AAL_LIMB_DIGITS;
+        }
+    } else {
+        *s->p++ = '0';
+    }
+
+    if (f == 0) {
+        // the zero limbs an integer leaves out
+        sinkZeros(s, (size_t)AAL_LIMB_DIGITS * bf.exp);
+        return;
+    }
+
+    sinkRoom(s, 1);
+    *s->p++ = '.';
+    if (f > bf.len) sinkZeros(s, (size_t)AAL_LIMB_DIGITS * (f - bf.len));
+    for (int i = (f < bf.len ? f : bf.len) - 1; i > 0; i--) {
+        sinkRoom(s, AAL_LIMB_DIGITS);
+        limbToChars(s->p, limbs[i]);
+        s->p += AAL_LIMB_DIGITS;
+    }
+    char digit[AAL_LIMB_DIGITS];
+    int keep = AAL_LIMB_DIGITS - limbTrailingZeros(limbs[0]);
+    limbToChars(digit, limbs[0]);
+    sinkRoom(s, keep);
+    memcpy(s->p, digit, keep);
+    s->p += keep;
+}
+
+// Exact length of the text formatBigFloat gives for bf, without the
+// terminator
+size_t formatBigFloatLen(BigFloat bf) {
+    const limb_t* limbs = bigFloatLimbs(&bf);
+    if (bf.len == 0) return 1;
+
+    size_t n = (bf.sign < 0);
+    if (bf.exp >= 0) return n + limbsDecimalLen(limbs, bf.len) + (size_t)AAL_LIMB_DIGITS * bf.exp;
+
+    // integer digits (or a single 0), the point, then every fractional
+    // digit up to the last nonzero one
+    int f = -bf.exp;
+    n += (bf.len > f) ? (size_t)limbsDecimalLen(limbs + f, bf.len - f) : 1;
+    return n + 1 + (size_t)AAL_LIMB_DIGITS * f - limbTrailingZeros(limbs[0]);
+}
+
+// Format bf into out, which must hold formatBigFloatLen(bf) + 1 bytes;
+// returns the length written, not counting the terminator
+size_t formatBigFloatTo(char* out, BigFloat bf) {
+    TextSink s = { out, NULL, out, NULL, 0 };
+    formatText(&s, bf);
+    *s.p = '\0';
+    return s.p - out;
+}
+
+// Format BigFloat as string
+char* formatBigFloat(BigFloat bf) {
+    char* res = malloc(formatBigFloatLen(bf) + 1);
+    if (res) formatBigFloatTo(res, bf);
+    return res;
+}
+
+// Stream a BigFloat to f in the same layout as formatBigFloat without
+// building the whole string, returns 0 on success and -1 on a write error
+int writeBigFloat(FILE* f, BigFloat bf) {
+    char buf[1 << 16];
+    TextSink s = { buf, buf + sizeof(buf), buf, f, 0 };
+    formatText(&s, bf);
+
+    size_t fill = s.p - buf;
+    if (fwrite(buf, 1, fill, f) != fill) s.failed = 1;
+    return (s.failed || ferror(f)) ? -1 : 0;
+}
+
+// Release the digit storage of a BigFloat
+void freeBigFloat(BigFloat* bf) {
+    limbsFree(bf->limbs);
+    bf->limbs = NULL;
+    bf->len = 0;
+    bf->cap = 0;
+}
+
+// ---------- Binary files ----------
+// A file holds one BigFloat: a 64 byte header, then the limbs as 32 bit
+// little endian words, least significant first. The header fields are
+// little endian as well:
+//    0 "AALB"          4 format version
+//    8 sign           12 exponent in limbs
+//   16 limb count     20 digits per limb (9)
+//   24 checksum       32 zero; room for the block header of a mapping
+// The checksum is Fletcher-64 over the header words at 4 to 23 and the
+// limb values, so it does not depend on the host's byte order.
+
+#define FILE_MAGIC "AALB"
+#define FILE_VERSION 1
+#define FILE_HEADER_BYTES 64
+
+static void putLE32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8*i));
+}
+
+static uint32_t getLE32(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// Whether limbs in memory have the layout they have in a file
+static int hostLittleEndian(void) {
+    const uint32_t one = 1;
+    return *(const unsigned char*)&one == 1;
+}
+
+// Fletcher-64 sums of n words, modulo 2^32-1; with words below 2^32 the
+// sums cannot overflow for 92679 words between reductions
+static void fletcherAdd(uint64_t* s1, uint64_t* s2, const uint32_t* w, int n) {
+    while (n > 0) {
+        int block = (n < 92679) ? n : 92679;
+        n -= block;
+        for (int i = 0; i < block; i++) {
+            *s1 += *w++;
+            *s2 += *s1;
+        }
+        *s1 %= 0xFFFFFFFFu;
+        *s2 %= 0xFFFFFFFFu;
+    }
+}
+
+// Checksum of a file with this header and these limbs
+static uint64_t fileChecksum(const unsigned char* header, const limb_t* limbs, int n) {
+    uint32_t fields[5];
+    uint64_t s1 = 0, s2 = 0;
+    for (int i = 0; i < 5; i++) fields[i] = getLE32(header + 4 + 4*i);
+    fletcherAdd(&s1, &s2, fields, 5);
+    fletcherAdd(&s1, &s2, limbs, n);
+    return s2 << 32 | s1;
+}
+
+static uint64_t fileStoredChecksum(const unsigned char* header) {
+    return (uint64_t)getLE32(header + 28) << 32 | getLE32(header + 24);
+}
+
+// Limb count of a file header, or -1 when it is not one this build reads
+static int fileHeaderLen(const unsigned char* header) {
+    int sign = (int)getLE32(header + 8);
+    uint32_t len = getLE32(header + 16);
+    if (memcmp(header, FILE_MAGIC, 4) != 0 || getLE32(header + 4) != FILE_VERSION ||
+        getLE32(header + 20) != AAL_LIMB_DIGITS || (sign != 1 && sign != -1) || len > INT_MAX) {
+        return -1;
+    }
+    return (int)len;
+}
+
+// Whether limbs are valid base 10^9 digits and match the stored checksum
+static int fileLimbsValid(const unsigned char* header, const limb_t* limbs, int n) {
+    for (int i = 0; i < n; i++) {
+        if (limbs[i] >= AAL_LIMB_BASE) return 0;
+    }
+    return fileChecksum(header, limbs, n) == fileStoredChecksum(header);
+}
+
+// Write bf to path in the binary format, returns 0 on success and -1 on failure
+int saveBigFloat(const char* path, BigFloat bf) {
+    const limb_t* limbs = bigFloatLimbs(&bf);
+    unsigned char header[FILE_HEADER_BYTES] = { 0 };
+    memcpy(header, FILE_MAGIC, 4);
+    putLE32(header + 4, FILE_VERSION);
+    putLE32(header + 8, (uint32_t)(bf.len ? bf.sign : 1));
+    putLE32(header + 12, (uint32_t)(bf.len ? bf.exp : 0));
+    putLE32(header + 16, (uint32_t)bf.len);
+    putLE32(header + 20, AAL_LIMB_DIGITS);
+    uint64_t sum = fileChecksum(header, limbs, bf.len);
+    putLE32(header + 24, (uint32_t)sum);
+    putLE32(header + 28, (uint32_t)(sum >> 32));
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return -1;
+    int ok = fwrite(header, 1, sizeof(header), f) == sizeof(header);
+    if (hostLittleEndian()) {
+        ok = ok && fwrite(limbs, sizeof(limb_t), bf.len, f) == (size_t)bf.len;
+    } else {
+        unsigned char buf[4096];
+        for (int i = 0; ok && i < bf.len; ) {
+            int n = 0;
+            for (; n < (int)sizeof(buf) / 4 && i < bf.len; n++) putLE32(buf + 4*n, limbs[i++]);
+            ok = fwrite(buf, 4, n, f) == (size_t)n;
+        }
+    }
+    if (fclose(f) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+// Give back the mapping a loaded BigFloat's limbs live in
+static void unmapLimbs(limb_t* p) {
+#ifndef _WIN32
+    unsigned char* base = (unsigned char*)p - FILE_HEADER_BYTES;
+    munmap(base, FILE_HEADER_BYTES + (size_t)getLE32(base + 16) * sizeof(limb_t));
+#else
+    (void)p;
+#endif
+}
+
+#ifndef _WIN32
+// Map path and use its limbs in place: only the header page is ever
+// written (copy on write, for the block header naming the mapping), so
+// the limbs are never copied. Returns 0 when the file is better read,
+// which also covers every kind of bad file
+static int mapBigFloat(const char* path, BigFloat* bf) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+        st.st_size <= FILE_HEADER_BYTES + AAL_SMALL_LIMBS * (off_t)sizeof(limb_t)) {
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)st.st_size;
+    unsigned char* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    int len = fileHeaderLen(map);
+    limb_t* limbs = (limb_t*)(map + FILE_HEADER_BYTES);
+    if (len < 0 || size != FILE_HEADER_BYTES + (size_t)len * sizeof(limb_t) ||
+        !fileLimbsValid(map, limbs, len)) {
+        munmap(map, size);
+        return 0;
+    }
+
+    LimbHeader* h = (LimbHeader*)limbs - 1;
+    h->ctx = &mappedFile;
+    bf->limbs = limbs;
+    bf->cap = len;
+    settleBigFloat(bf, len, (int)getLE32(map + 12), (int)getLE32(map + 8));
+    return 1;
+}
+#endif
+
+// Read a BigFloat written by saveBigFloat. Where the platform allows it
+// the file is mapped and its limbs are used where they lie, so loading
+// costs one pass for the checksum and no copy; the mapping goes away with
+// the BigFloat. Bad files print an error, leave zero in *bf and return -1
+int readBigFloatFile(const char* path, BigFloat* bf) {
+    BigFloat res = zeroBigFloat();
+    *bf = res;
+#ifndef _WIN32
+    if (hostLittleEndian() && mapBigFloat(path, bf)) return 0;
+#endif
+
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Cannot open %s!\n", path);
+        return -1;
+    }
+
+    unsigned char header[FILE_HEADER_BYTES];
+    int len = (fread(header, 1, sizeof(header), f) == sizeof(header)) ? fileHeaderLen(header) : -1;
+    if (len < 0) {
+        fprintf(stderr, "Not a BigFloat file: %s!\n", path);
+        fclose(f);
+        return -1;
+    }
+
+    limb_t* r = resultLimbs(&res, len);
+    int ok = fread(r, sizeof(limb_t), len, f) == (size_t)len && fgetc(f) == EOF;
+    if (ok && !hostLittleEndian()) {
+        for (int i = 0; i < len; i++) r[i] = getLE32((const unsigned char*)&r[i]);
+    }
+    fclose(f);
+
+    if (!ok || !fileLimbsValid(header, r, len)) {
+        fprintf(stderr, "Corrupt BigFloat file: %s!\n", path);
+        limbsFree(res.limbs);
+        return -1;
+    }
+    settleBigFloat(&res, len, (int)getLE32(header + 12), (int)getLE32(header + 8));
+    *bf = res;
+    return 0;
+}
+
+// readBigFloatFile for callers that take zero for a bad file
+BigFloat loadBigFloat(const char* path) {
+    BigFloat res;
+    readBigFloatFile(path, &res);
+    return res;
+}
+
+// ---------- BigFloat arithmetic ----------
+
+// |x| + |y|*B^d for d >= 0, as a BigFloat with the given exponent and sign.
+// The result is exact, so for d > lx the d - lx limbs between the operands
+// are stored as zeros and the cost grows with the gap in magnitude
+static BigFloat addMagnitudes(const limb_t* x, int lx, const limb_t* y, int ly, int d, int exp, int sign) {
+    int n = (lx > ly + d) ? lx : ly + d;
+    BigFloat res;
+    limb_t* r = resultLimbs(&res, n+1);
+    if (lx <= d) {
+        // no overlap: x, the zero limbs between them, then y
+        memcpy(r, x, lx * sizeof(limb_t));
+        memset(r + lx, 0, (d - lx) * sizeof(limb_t));
+        memcpy(r + d, y, ly * sizeof(limb_t));
+        r[n] = 0;
+    } else {
+        if (d > 0) memcpy(r, x, d * sizeof(limb_t));
+        x += d;
+        lx -= d;
+        if (lx < ly) {
+            const limb_t* t = x; x = y; y = t;
+            int tl = lx; lx = ly; ly = tl;
+        }
+        r[n] = limbsAdd(r + d, x, lx, y, ly);
+    }
+    settleBigFloat(&res, n+1, exp, sign);
+    return res;
+}
+
+// |x|*B^dx - |y|*B^dy as a BigFloat, assumes the first is the larger and
+// one of dx, dy is zero
+static BigFloat subMagnitudes(const limb_t* x, int lx, int dx, const limb_t* y, int ly, int dy, int exp, int sign) {
+    int n = lx + dx;
+    BigFloat res;
+    limb_t* r = resultLimbs(&res, n);
+    if (dx == 0) {
+        // the limbs of x below y pass straight through
+        if (dy > 0) memcpy(r, x, dy * sizeof(limb_t));
+        limbsSub(r + dy, x + dy, lx - dy, y, ly);
+    } else {
+        memset(r, 0, dx * sizeof(limb_t));
+        memcpy(r + dx, x, lx * sizeof(limb_t));
+        limbsSub(r, r, n, y, ly);
+    }
+    settleBigFloat(&res, n, exp, sign);
+    return res;
+}
+
+// Compare |x|*B^dx with |y|*B^dy for normalized magnitudes
+static int limbsCmpShifted(const limb_t* x, int lx, int dx, const limb_t* y, int ly, int dy) {
+    if (lx + dx != ly + dy) return (lx + dx > ly + dy) ? 1 : -1;
+    for (int i = lx + dx - 1; i >= 0; i--) {
+        limb_t u = (i >= dx) ? x[i-dx] : 0;
+        limb_t v = (i >= dy) ? y[i-dy] : 0;
+        if (u != v) return (u > v) ? 1 : -1;
+    }
+    return 0;
+}
+
+// a + b, the common body of addBigFloat and subBigFloat
+static BigFloat addValues(BigFloat a, BigFloat b) {
+    if (b.len == 0) {
+        BigFloat t = a; a = b; b = t;
+    }
+    if (a.len == 0) {
+        BigFloat res;
+        memcpy(resultLimbs(&res, b.len), bigFloatLimbs(&b), b.len * sizeof(limb_t));
+        settleBigFloat(&res, b.len, b.exp, b.sign);
+        return res;
+    }
+
+    // align on the lower exponent: b sits d limbs above a
+    if (a.exp > b.exp) {
+        BigFloat t = a; a = b; b = t;
+    }
+    int d = b.exp - a.exp;
+    const limb_t* x = bigFloatLimbs(&a);
+    const limb_t* y = bigFloatLimbs(&b);
+
+    if (a.sign == b.sign) return addMagnitudes(x, a.len, y, b.len, d, a.exp, a.sign);
+    int cmp = limbsCmpShifted(x, a.len, 0, y, b.len, d);
+    if (cmp == 0) return zeroBigFloat();
+    if (cmp > 0) return subMagnitudes(x, a.len, 0, y, b.len, d, a.exp, a.sign);
+    return subMagnitudes(y, b.len, d, x, a.len, 0, a.exp, b.sign);
+}
+
+// BigFloat addition
+BigFloat addBigFloat(BigFloat a, BigFloat b) {
+    STATS_OP(AAL_STAT_ADD, a.len > b.len ? a.len : b.len);
+    return addValues(a, b);
+}
+
+// BigFloat subtraction: a - b
+BigFloat subBigFloat(BigFloat a, BigFloat b) {
+    STATS_OP(AAL_STAT_SUB, a.len > b.len ? a.len : b.len);
+    BigFloat negB = b;
+    negB.sign = -negB.sign;   // flip the sign of b
+    return addValues(a, negB);
+}
+
+// BigFloat multiplication
+BigFloat mulBigFloat(BigFloat a, BigFloat b) {
+    STATS_OP(AAL_STAT_MUL, a.len > b.len ? a.len : b.len);
+    BigFloat res;
+    const limb_t* x = bigFloatLimbs(&a);
+    const limb_t* y = bigFloatLimbs(&b);
+
+    // inline operands arrive as separate copies, so a square has to be
+    // recognized by value
+    if (!a.limbs && !b.limbs && a.len == b.len) {
+        int i = 0;
+        while (i < a.len && x[i] == y[i]) i++;
+        if (i == a.len) y = x;
+    }
+
+    limb_t* r = resultLimbs(&res, a.len + b.len);
+    limbsMul(r, x, a.len, y, b.len);
+    settleBigFloat(&res, a.len + b.len, a.exp + b.exp, a.sign * b.sign);
+    return res;
+}
+
+// BigFloat square, cheaper than mulBigFloat(a, b) on distinct operands
+BigFloat sqrBigFloat(BigFloat a) {
+    STATS_OP(AAL_STAT_SQR, a.len);
+    BigFloat res;
+    limb_t* r = resultLimbs(&res, 2*a.len);
+    const limb_t* x = bigFloatLimbs(&a);
+    limbsMul(r, x, a.len, x, a.len);
+    settleBigFloat(&res, 2*a.len, 2*a.exp, 1);
+    return res;
+}
+
+// Whether tier can run at the top level for n limb operands: each tier
+// splits into parts that must all be non-empty
+static int mulTierFits(int n, AALMulTier tier) {
+    switch (tier) {
+        case AAL_MUL_KARATSUBA: return n >= 2;
+        case AAL_MUL_TOOM3: return n > 2*((n+2)/3);
+        case AAL_MUL_TOOM4: return n > 3*((n+3)/4);
+        case AAL_MUL_NTT: return 2*n <= NTT_MAX_LEN;
+        default: return 1;
+    }
+}
+
+// BigFloat multiplication with the top level algorithm forced to tier,
+// for benchmarks and cross checks; falls back to mulBigFloat when the
+// operands are too small for it
+BigFloat mulBigFloatTier(BigFloat a, BigFloat b, AALMulTier tier) {
+    int n = (a.len > b.len) ? a.len : b.len;
+    if (tier == AAL_MUL_AUTO || a.len == 0 || b.len == 0 || !mulTierFits(n, tier)) {
+        return mulBigFloat(a, b);
+    }
+    STATS_OP(AAL_STAT_MUL, n);
+
+    // the tiers take equal length operands, so pad the shorter one
+    int square = (a.limbs && a.limbs == b.limbs && a.len == b.len);
+    limb_t* pa = NULL;
+    limb_t* pb = NULL;
+    const limb_t* x = bigFloatLimbs(&a);
+    const limb_t* y = bigFloatLimbs(&b);
+    if (a.len < n) {
+        pa = limbsAlloc(n);
+        memcpy(pa, x, a.len * sizeof(limb_t));
+        memset(pa + a.len, 0, (n - a.len) * sizeof(limb_t));
+        x = pa;
+    }
+    if (b.len < n) {
+        pb = limbsAlloc(n);
+        memcpy(pb, y, b.len * sizeof(limb_t));
+        memset(pb + b.len, 0, (n - b.len) * sizeof(limb_t));
+        y = pb;
+    }
+    if (square) y = x;
+
+    int need = mulTierScratch(n, tier);
+    limb_t* scratch = need ? limbsAlloc(need) : NULL;
+    limb_t* r = limbsAlloc(2*n);
+    limbsMulTier(r, x, y, n, scratch, tier);
+
+    limbsFree(scratch);
+    limbsFree(pa);
+    limbsFree(pb);
+    return makeBigFloat(r, 2*n, a.exp + b.exp, a.sign * b.sign);
+}
+
+// ---------- Destination passing arithmetic ----------
+// These write into an existing BigFloat and reuse its buffer, growing it
+// geometrically only when the result does not fit. A zero initialized
+// BigFloat is a valid (zero) destination.
+
+// Make room for n limbs in bf, keeping its digits; the inline limbs serve
+// until n outgrows them
+static void bigFloatReserve(BigFloat* bf, int n) {
+    int have = bf->limbs ? bf->cap : AAL_SMALL_LIMBS;
+    if (n <= have) return;
+    int cap = have + have / 2;
+    if (cap < n) cap = n;
+    limb_t* p = limbsAlloc(cap);
+    if (bf->len) memcpy(p, bigFloatLimbs(bf), bf->len * sizeof(limb_t));
+    limbsFree(bf->limbs);
+    bf->limbs = p;
+    bf->cap = cap;
+}
+
+// Copy src into dst's storage
+static void assignBigFloat(BigFloat* dst, BigFloat src) {
+    bigFloatReserve(dst, src.len);
+    if (src.len) memcpy(bigFloatLimbs(dst), bigFloatLimbs(&src), src.len * sizeof(limb_t));
+    dst->len = src.len;
+    dst->exp = src.len ? src.exp : 0;
+    dst->sign = src.len ? src.sign : 1;
+}
+
+// Replace dst with a freshly computed result
+static void replaceBigFloat(BigFloat* dst, BigFloat res) {
+    freeBigFloat(dst);
+    *dst = res;
+}
+
+// acc += sign*x in acc's own buffer; x must not share that buffer
+static void accumulate(BigFloat* acc, BigFloat x, int sign) {
+    if (x.len == 0) return;
+    sign *= x.sign;
+    if (acc->len == 0) {
+        // x may be a raw product whose lowest limbs are zero
+        assignBigFloat(acc, x);
+        acc->sign = sign;
+        bigFloatCompact(acc);
+        return;
+    }
+
+    // when x reaches lower, move acc's limbs up to x's exponent
+    if (x.exp < acc->exp) {
+        int w = acc->exp - x.exp;
+        bigFloatReserve(acc, acc->len + w + 1);
+        limb_t* r = bigFloatLimbs(acc);
+        memmove(r + w, r, acc->len * sizeof(limb_t));
+        memset(r, 0, w * sizeof(limb_t));
+        acc->len += w;
+        acc->exp = x.exp;
+    }
+
+    // x is added w limbs up
+    int w = x.exp - acc->exp;
+    int n = (acc->len > w + x.len) ? acc->len + 1 : w + x.len + 1;
+    bigFloatReserve(acc, n);
+    limb_t* r = bigFloatLimbs(acc);
+    memset(r + acc->len, 0, (n - acc->len) * sizeof(limb_t));
+
+    const limb_t* y = bigFloatLimbs(&x);
+    if (sign == acc->sign) {
+        limbsAdd(r + w, r + w, n - w, y, x.len);
+    } else if (limbsSub(r + w, r + w, n - w, y, x.len)) {
+        // |x| was larger: r holds B^n - (|x| - |acc|), so complement it
+        for (int j = 0; j < n; j++) r[j] = AAL_LIMB_BASE - 1 - r[j];
+        for (int j = 0; j < n && ++r[j] == AAL_LIMB_BASE; j++) r[j] = 0;
+        acc->sign = sign;
+    }
+
+    acc->len = limbsNormLen(r, n);
+    bigFloatCompact(acc);
+}
+
+// dst = a + sign*b; only heap limbs can alias, inline ones travel by value
+static void addBigFloatSigned(BigFloat* dst, BigFloat a, BigFloat b, int sign) {
+    STATS_OP(sign > 0 ? AAL_STAT_ADD : AAL_STAT_SUB, a.len > b.len ? a.len : b.len);
+    int aliasA = (a.len && a.limbs && a.limbs == dst->limbs);
+    int aliasB = (b.len && b.limbs && b.limbs == dst->limbs);
+    if (aliasA && aliasB) {
+        b.sign *= sign;
+        replaceBigFloat(dst, addValues(a, b));
+    } else if (aliasA) {
+        accumulate(dst, b, sign);
+    } else if (aliasB) {
+        // dst holds b: a - b = -(b - a)
+        accumulate(dst, a, sign);
+        if (sign < 0 && dst->len) dst->sign = -dst->sign;
+    } else {
+        assignBigFloat(dst, a);
+        accumulate(dst, b, sign);
+    }
+}
+
+// dst = a + b; dst may be one of the operands
+void addBigFloatTo(BigFloat* dst, BigFloat a, BigFloat b) {
+    addBigFloatSigned(dst, a, b, 1);
+}
+
+// dst = a - b; dst may be one of the operands
+void subBigFloatTo(BigFloat* dst, BigFloat a, BigFloat b) {
+    addBigFloatSigned(dst, a, b, -1);
+}
+
+// acc += x
+void addBigFloatInPlace(BigFloat* acc, BigFloat x) {
+    addBigFloatSigned(acc, *acc, x, 1);
+}
+
+// acc -= x
+void subBigFloatInPlace(BigFloat* acc, BigFloat x) {
+    addBigFloatSigned(acc, *acc, x, -1);
+}
+
+// dst = a * b; dst may be one of the operands
+void mulBigFloatTo(BigFloat* dst, BigFloat a, BigFloat b) {
+    if ((a.len && a.limbs && a.limbs == dst->limbs) || (b.len && b.limbs && b.limbs == dst->limbs)) {
+        replaceBigFloat(dst, mulBigFloat(a, b));
+        return;
+    }
+    STATS_OP(AAL_STAT_MUL, a.len > b.len ? a.len : b.len);
+    if (a.len == 0 || b.len == 0) {
+        dst->len = 0;
+        dst->exp = 0;
+        dst->sign = 1;
+        return;
+    }
+
+    // the old digits are not needed, so do not carry them over
+    dst->len = 0;
+    bigFloatReserve(dst, a.len + b.len);
+    limb_t* r = bigFloatLimbs(dst);
+    limbsMul(r, bigFloatLimbs(&a), a.len, bigFloatLimbs(&b), b.len);
+    dst->len = limbsNormLen(r, a.len + b.len);
+    dst->exp = a.exp + b.exp;
+    dst->sign = a.sign * b.sign;
+    bigFloatCompact(dst);
+}
+
+// acc += sign*a*b
+static void mulAddSigned(BigFloat* acc, BigFloat a, BigFloat b, int sign) {
+    if (a.len == 0 || b.len == 0) return;
+    if ((a.limbs && a.limbs == acc->limbs) || (b.limbs && b.limbs == acc->limbs)) {
+        BigFloat prod = mulBigFloat(a, b);
+        accumulate(acc, prod, sign);
+        freeBigFloat(&prod);
+        return;
+    }
+    STATS_OP(AAL_STAT_MUL, a.len > b.len ? a.len : b.len);
+
+    // small products stay on the stack, so dot products of short operands
+    // never allocate once acc has grown
+    limb_t stack[64];
+    int n = a.len + b.len;
+    BigFloat prod;
+    prod.limbs = (n <= 64) ? stack : limbsAlloc(n);
+    limbsMul(prod.limbs, bigFloatLimbs(&a), a.len, bigFloatLimbs(&b), b.len);
+    prod.len = limbsNormLen(prod.limbs, n);
+    prod.cap = n;
+    prod.exp = a.exp + b.exp;
+    prod.sign = a.sign * b.sign;
+    accumulate(acc, prod, sign);
+    if (prod.limbs != stack) limbsFree(prod.limbs);
+}
+
+// acc += a * b
+void mulAddBigFloat(BigFloat* acc, BigFloat a, BigFloat b) {
+    mulAddSigned(acc, a, b, 1);
+}
+
+// acc -= a * b
+void mulSubBigFloat(BigFloat* acc, BigFloat a, BigFloat b) {
+    mulAddSigned(acc, a, b, -1);
+}
+
+// Quotient q truncated to precision fractional digits and/or the remainder
+// a - q*b, both from a single division (either output may be NULL)
+static void divmodCore(BigFloat a, BigFloat b, int precision, BigFloat* quotient, BigFloat* remainder) {
+    STATS_OP(AAL_STAT_DIV, a.len > b.len ? a.len : b.len);
+    if (precision < 0) precision = 0;
+
+    // q keeps k fractional limbs of which the last pad digits are zero, so
+    // with A, D the significands q*B^k = floor(A*B^t / (D*10^pad))*10^pad
+    // for t = a.exp - b.exp + k, and a - q*b = R*B^(b.exp-k) for the
+    // remainder R of that division
+    int k = digitLimbs(precision);
+    int pad = digitPad(precision);
+    long long shift = a.len ? (long long)a.exp - b.exp + k : 0;
+    if (shift > INT_MAX - a.len || shift < b.len - INT_MAX) {
+        fprintf(stderr, "Precision too large!\n");
+        if (quotient) *quotient = zeroBigFloat();
+        if (remainder) *remainder = zeroBigFloat();
+        return;
+    }
+    int t = (int)shift;
+    const limb_t* A = bigFloatLimbs(&a);
+    const limb_t* D = bigFloatLimbs(&b);
+
+    // small operands divide without touching the heap
+    limb_t bufD[2 * AAL_SMALL_LIMBS], bufX[2 * AAL_SMALL_LIMBS];
+    limb_t* padded = NULL;
+    if (pad > 0) {
+        padded = scratchLimbs(bufD, b.len + 1);
+        padded[b.len] = limbsMul1(padded, D, b.len, pow10Limb[pad]);
+        b.len = limbsNormLen(padded, b.len + 1);
+        D = padded;
+    }
+
+    // t > 0 puts zero limbs under A; t < 0 leaves the lowest -t limbs of A
+    // out of the division, to be put back under its remainder
+    int low = (t < 0) ? -t : 0;
+    int lx = a.len + t;
+    const limb_t* x = NULL;
+    limb_t* shifted = NULL;
+    if (t > 0) {
+        x = shifted = scratchLimbs(bufX, lx);
+        memset(shifted, 0, t * sizeof(limb_t));
+        memcpy(shifted + t, A, a.len * sizeof(limb_t));
+    } else if (lx > 0) {
+        x = A + low;
+    } else {
+        lx = 0;
+    }
+
+    int qlen = (lx >= b.len) ? lx - b.len + 1 : 1;
+    BigFloat Q, R;
+    limb_t* q = resultLimbs(&Q, qlen + 1);
+    limb_t* rem = resultLimbs(&R, low + b.len);
+    if (lx > 0) {
+        limbsDivRem(q, rem + low, x, lx, D, b.len);
+    } else {
+        q[0] = 0;
+        memset(rem + low, 0, b.len * sizeof(limb_t));
+    }
+
+    if (remainder) {
+        int kept = (a.len < low) ? a.len : low;
+        memcpy(rem, A, kept * sizeof(limb_t));
+        memset(rem + kept, 0, (low - kept) * sizeof(limb_t));
+        settleBigFloat(&R, low + b.len, (t < 0) ? a.exp : b.exp - k, a.sign);
+        *remainder = R;
+    } else {
+        limbsFree(R.limbs);
+    }
+
+    if (quotient) {
+        q[qlen] = pad ? limbsMul1(q, q, qlen, pow10Limb[pad]) : 0;
+        settleBigFloat(&Q, qlen + 1, -k, a.sign * b.sign);
+        *quotient = Q;
+    } else {
+        limbsFree(Q.limbs);
+    }
+
+    if (shifted) scratchFree(shifted, bufX);
+    if (padded) scratchFree(padded, bufD);
+}
+
+BigFloat divBigFloat(BigFloat a, BigFloat b, int precision) {
+    if (b.len == 0) {
+        fprintf(stderr, "Division by zero!\n");
+        return zeroBigFloat();
+    }
+
+    BigFloat res;
+    divmodCore(a, b, precision, &res, NULL);
+    return res;
+}
+
+BigFloat modBigFloat(BigFloat a, BigFloat b) {
+    if (b.len == 0) {
+        fprintf(stderr, "Modulo by zero!\n");
+        return zeroBigFloat();
+    }
+
+    // remainder takes the dividend's sign
+    BigFloat res;
+    divmodCore(a, b, 0, NULL, &res);
+    return res;
+}
+
+// Quotient (to precision fractional digits) and a mod b, the remainder of
+// the integer quotient. The integer division comes first; since a/b is
+// q + r/b with |r/b| < 1 of the same sign, the fractional digits are those
+// of r/b, a division of b's size only
+void divmodBigFloat(BigFloat a, BigFloat b, int precision, BigFloat* quotient, BigFloat* remainder) {
+    if (b.len == 0) {
+        fprintf(stderr, "Division by zero!\n");
+        *quotient = zeroBigFloat();
+        *remainder = zeroBigFloat();
+        return;
+    }
+
+    divmodCore(a, b, 0, quotient, remainder);
+    if (precision > 0 && remainder->len) {
+        BigFloat frac;
+        divmodCore(*remainder, b, precision, &frac, NULL);
+        addBigFloatInPlace(quotient, frac);
+        freeBigFloat(&frac);
+    }
+}
+
+// ---------- Powers ----------
+
+// Cut bf to precision fractional digits (at least 0), truncating toward zero
+static void truncateDigits(BigFloat* bf, int precision) {
+    if (precision < 0) precision = 0;
+
+    // the limb holding digit 10^-precision, and the digits below it there
+    int k = digitLimbs(precision);
+    long long drop = -(long long)k - bf->exp;
+    if (bf->len == 0 || drop < 0) return;
+    if (drop >= bf->len) {
+        bf->len = 0;
+        bigFloatCompact(bf);
+        return;
+    }
+
+    int cut = (int)drop;
+    limb_t unit = pow10Limb[digitPad(precision)];
+    limb_t* limbs = bigFloatLimbs(bf);
+    limbs[cut] -= limbs[cut] % unit;
+    memmove(limbs, limbs + cut, (bf->len - cut) * sizeof(limb_t));
+    bf->len = limbsNormLen(limbs, bf->len - cut);
+    bf->exp += cut;
+    bigFloatCompact(bf);
+}
+
+// Multiply bf by 10^k in place, exactly: the exponent moves by whole limbs
+// and the significand by the 0 to 8 digits left over
+static void shiftDecimal(BigFloat* bf, int k) {
+    if (bf->len == 0) return;
+    int whole = (k >= 0) ? k / AAL_LIMB_DIGITS : -digitLimbs(-k);
+    int rest = (k >= 0) ? k % AAL_LIMB_DIGITS : digitPad(-k);
+    bf->exp += whole;
+    if (rest == 0) return;
+
+    bigFloatReserve(bf, bf->len + 1);
+    limb_t* limbs = bigFloatLimbs(bf);
+    limbs[bf->len] = limbsMul1(limbs, limbs, bf->len, pow10Limb[rest]);
+    bf->len = limbsNormLen(limbs, bf->len + 1);
+    bigFloatCompact(bf);
+}
+
+// Fractional digits bf is written with before trailing zeros are stripped
+static int fracDigits(BigFloat bf) {
+    return (bf.exp < 0) ? -AAL_LIMB_DIGITS * bf.exp : 0;
+}
+
+// Replace *acc with res, cut back to keep significant digits (keep < 0
+// keeps them all); only fractional digits are ever dropped
+static void powReplace(BigFloat* acc, BigFloat res, long long keep) {
+    replaceBigFloat(acc, res);
+    if (keep >= 0) {
+        long long drop = limbsDecimalLen(bigFloatLimbs(acc), acc->len) - keep;
+        if (drop > 0) truncateDigits(acc, drop >= fracDigits(*acc) ? 0 : fracDigits(*acc) - (int)drop);
+    }
+}
+
+// Widest window powWindow picks: pow exponents are at most 64 bits, which
+// wider windows would not pay for
+#define POW_WINDOW_MAX 3
+
+// Window width for a sliding window over an exponent of bits bits
+static int powWindow(int bits) {
+    if (bits < 8) return 1;
+    if (bits < 24) return 2;
+    return POW_WINDOW_MAX;
+}
+
+// base^e for e >= 1, scanning e left to right in windows of up to k bits
+// (at most POW_WINDOW_MAX) that end in a one bit, so each window costs its
+// squarings plus one multiplication by a precomputed odd power
+static BigFloat powWindowed(BigFloat base, unsigned long e, long long keep) {
+    int bits = 0;
+    while (bits < (int)(8 * sizeof(e)) && (e >> bits) != 0) bits++;
+    int k = powWindow(bits);
+
+    // odd powers base^1, base^3, ..., base^(2^k - 1)
+    BigFloat odd[1 << (POW_WINDOW_MAX - 1)];
+    int count = 1 << (k-1);
+    memset(odd, 0, sizeof(odd));
+    assignBigFloat(&odd[0], base);
+    if (count > 1) {
+        BigFloat base2 = sqrBigFloat(base);
+        for (int i = 1; i < count; i++) powReplace(&odd[i], mulBigFloat(odd[i-1], base2), keep);
+        freeBigFloat(&base2);
+    }
+
+    BigFloat acc = { 0 };
+    int started = 0;
+    for (int i = bits-1; i >= 0; ) {
+        if (!((e >> i) & 1)) {
+            powReplace(&acc, sqrBigFloat(acc), keep);
+            i--;
+            continue;
+        }
+
+        // longest window e[i..j] of at most k bits with e[j] set
+        int j = (i - k + 1 > 0) ? i - k + 1 : 0;
+        while (!((e >> j) & 1)) j++;
+        unsigned long w = (e >> j) & ((2UL << (i - j)) - 1);
+
+        if (started) {
+            for (int s = 0; s <= i - j; s++) powReplace(&acc, sqrBigFloat(acc), keep);
+            powReplace(&acc, mulBigFloat(acc, odd[w >> 1]), keep);
+        } else {
+            assignBigFloat(&acc, odd[w >> 1]);
+            started = 1;
+        }
+        i = j - 1;
+    }
+
+    for (int i = 0; i < count; i++) freeBigFloat(&odd[i]);
+    return acc;
+}
+
+// base^exponent by sliding window exponentiation
+// With precision >= 0 the result is truncated to precision fractional digits
+// (within one unit in the last place) and intermediates keep only the digits
+// that can reach it, so fractional bases do not grow without bound.
+// precision < 0 gives the exact power; negative exponents need a precision.
+// The power goes to *res; on error zero is left there and -1 returned.
+int powBigFloatChecked(BigFloat base, long exponent, int precision, BigFloat* res) {
+    STATS_OP(AAL_STAT_POW, base.len);
+    unsigned long e = (exponent < 0) ? 0UL - (unsigned long)exponent : (unsigned long)exponent;
+    *res = zeroBigFloat();
+    if (exponent < 0 && precision < 0) {
+        fprintf(stderr, "Negative exponent needs a precision!\n");
+        return -1;
+    }
+    if (exponent < 0 && base.len == 0) {
+        fprintf(stderr, "Division by zero!\n");
+        return -1;
+    }
+    if (exponent == 0) {
+        *res = smallBigFloat(1, 0);
+        return 0;
+    }
+    if (base.len == 0) return 0;
+
+    // |base| < 10^intDigits, so |base^e| < 10^(e*intDigits); sizes are
+    // estimated in double since e*digits can overflow any integer type.
+    // Only the significand is stored, the exponent just grows e times.
+    double digits = limbsDecimalLen(bigFloatLimbs(&base), base.len);
+    double intDigits = digits + (double)AAL_LIMB_DIGITS * base.exp;
+    double size = e * digits;
+    if (e * fabs((double)base.exp) > INT_MAX / AAL_LIMB_DIGITS) {
+        fprintf(stderr, "Power too large!\n");
+        return -1;
+    }
+    long long keep = -1;
+    if (precision >= 0) {
+        // digits before the point of the result, which is 1/base^e for
+        // negative exponents
+        double whole = (exponent > 0) ? e * intDigits : e * (1 - intDigits);
+        if (whole < 0) whole = 0;
+
+        // enough significant digits for precision fractional ones, plus
+        // guard digits for the truncation of every intermediate
+        int guard = 3;
+        for (unsigned long t = e; t; t /= 10) guard++;
+        double cut = (double)precision + guard + whole;
+        if (cut <= INT_MAX) keep = (long long)cut;
+
+        // integer digits are never dropped
+        if (e * intDigits > cut) cut = e * intDigits;
+        if (cut < size) size = cut;
+    }
+    if (size > INT_MAX / 2) {
+        fprintf(stderr, "Power too large!\n");
+        return -1;
+    }
+
+    BigFloat p = powWindowed(base, e, keep);
+    if (precision >= 0 && exponent > 0) {
+        truncateDigits(&p, precision);
+    } else if (exponent < 0) {
+        // base^-e = 1 / base^e
+        BigFloat one = smallBigFloat(1, 0);
+        BigFloat inv = divBigFloat(one, p, precision);
+        freeBigFloat(&one);
+        freeBigFloat(&p);
+        p = inv;
+    }
+    *res = p;
+    return 0;
+}
+
+// powBigFloatChecked for callers that take zero for an error
+BigFloat powBigFloat(BigFloat base, long exponent, int precision) {
+    BigFloat res;
+    powBigFloatChecked(base, exponent, precision, &res);
+    return res;
+}
+
+// ---------- Fixed precision multiplication ----------
+
+// Decimal digit pos of a magnitude (0 is the least significant)
+static int digitAt(const limb_t* a, int n, int pos) {
+    int i = pos / AAL_LIMB_DIGITS;
+    if (i >= n) return 0;
+    return (a[i] / pow10Limb[pos % AAL_LIMB_DIGITS]) % 10;
+}
+
+// Round bf to precision fractional digits, half away from zero
+static void roundDigits(BigFloat* bf, int precision) {
+    if (precision < 0) precision = 0;
+    long long pos = (long long)fracDigits(*bf) - precision - 1;
+    if (pos < 0 || bf->len == 0) return;
+
+    int up = pos < (long long)AAL_LIMB_DIGITS * bf->len && digitAt(bigFloatLimbs(bf), bf->len, (int)pos) >= 5;
+    int sign = bf->sign;
+    truncateDigits(bf, precision);
+    if (up) {
+        // one unit in the last kept place
+        int k = digitLimbs(precision);
+        limb_t unit = pow10Limb[digitPad(precision)];
+        BigFloat u;
+        u.limbs = &unit;
+        u.len = 1;
+        u.cap = 1;
+        u.exp = -k;
+        u.sign = sign;
+        accumulate(bf, u, 1);
+    }
+}
+
+// a*b rounded to precision fractional digits (half away from zero), from
+// the high part of the product only. With drop product digits below the
+// precision, the columns below c = drop/9 - 3 limbs are never formed: what
+// they could carry up is under B^2 in units of B^c, so it can only change
+// the rounding digit when that is a 4 followed by nines down to the carry,
+// and then the full product settles it. Operand limbs that only reach the
+// skipped columns are not read at all, so results and inputs stay at the
+// working precision through chained products.
+BigFloat mulBigFloatPrec(BigFloat a, BigFloat b, int precision) {
+    if (precision < 0) precision = 0;
+    if (a.len == 0 || b.len == 0) return zeroBigFloat();
+    long long drop = -(long long)AAL_LIMB_DIGITS * (a.exp + b.exp) - precision;
+    if (drop <= 0) return mulBigFloat(a, b);
+    STATS_OP(AAL_STAT_MUL, a.len > b.len ? a.len : b.len);
+
+    long long c = drop / AAL_LIMB_DIGITS - 3;
+    int sign = a.sign * b.sign;
+    if (c >= a.len + b.len - 1) {
+        // the product is below B^(c+1), under half a unit of the result
+        return zeroBigFloat();
+    }
+    if (c > 0) {
+        // a[i]*b[j] only reaches column c when i+j >= c
+        int ta = (c - b.len + 1 > 0) ? (int)c - b.len + 1 : 0;
+        int tb = (c - a.len + 1 > 0) ? (int)c - a.len + 1 : 0;
+        int cc = (int)c - ta - tb;
+        const limb_t* x = bigFloatLimbs(&a) + ta;
+        const limb_t* y = bigFloatLimbs(&b) + tb;
+        int lx = a.len - ta, ly = b.len - tb;
+        if (lx < ly) {
+            const limb_t* t = x; x = y; y = t;
+            int tl = lx; lx = ly; ly = tl;
+        }
+
+        int n = lx + ly - cc;
+        limb_t* r = limbsAlloc(n + 1);
+        limbsMulHigh(r, x, lx, y, ly, cc);
+        r[n] = 0;
+
+        // r approximates the product in units of B^c, so d digits remain
+        int d = (int)(drop - AAL_LIMB_DIGITS * c);
+        int nines = 1;
+        for (int pos = 2 * AAL_LIMB_DIGITS; pos < d-1 && nines; pos++) {
+            nines = digitAt(r, n, pos) == 9;
+        }
+        if (digitAt(r, n, d-1) != 4 || !nines) {
+            BigFloat res = makeBigFloat(r, n + 1, a.exp + b.exp + (int)c, sign);
+            roundDigits(&res, precision);
+            return res;
+        }
+        limbsFree(r);
+    }
+
+    // too close to call (or too short to bother): round the full product
+    BigFloat res = mulBigFloat(a, b);
+    roundDigits(&res, precision);
+    return res;
+}
+
+// ---------- Square roots ----------
+
+// Copy of x cut to at most digits fractional digits
+static BigFloat truncatedCopy(BigFloat x, int digits) {
+    BigFloat r = { 0 };
+    assignBigFloat(&r, x);
+    truncateDigits(&r, digits);
+    return r;
+}
+
+// Replace *x with res cut to at most digits fractional digits
+static void replaceTruncated(BigFloat* x, BigFloat res, int digits) {
+    replaceBigFloat(x, res);
+    truncateDigits(x, digits);
+}
+
+// floor(sqrt(n)) for an integer n > 0, with n - root^2 in *remainder
+// (may be NULL). Newton's iteration v += v*(1 - X*v^2)/2 converges to
+// 1/sqrt(X) for X = n/10^(2c) in [1, 100); every step doubles the digits
+// it works with, so the whole run costs a few multiplications at full size.
+// root = X*v*10^c is then off by at most a unit or two and the remainder
+// corrects it.
+static BigFloat isqrtRem(BigFloat n, BigFloat* remainder) {
+    const limb_t* N = bigFloatLimbs(&n);
+    int digits = limbsDecimalLen(N, n.len) + AAL_LIMB_DIGITS * n.exp;
+    int c = (digits - 1) / 2;
+    BigFloat X = { 0 };
+    assignBigFloat(&X, n);
+    shiftDecimal(&X, -2*c);
+
+    // 1/sqrt(X) to about 14 digits from the leading limbs in double
+    int lo = (n.len > 3) ? n.len - 3 : 0;
+    double x = 0;
+    for (int i = n.len-1; i >= lo; i--) x = x * AAL_LIMB_BASE + N[i];
+    for (int e = AAL_LIMB_DIGITS * (lo + n.exp) - 2*c; e < 0; e++) x /= 10;
+    for (int e = AAL_LIMB_DIGITS * (lo + n.exp) - 2*c; e > 0; e--) x *= 10;
+    BigFloat v = smallBigFloat((uint64_t)(1e15 / sqrt(x)), 15);
+    BigFloat half = smallBigFloat(5, 1);
+    BigFloat one = smallBigFloat(1, 0);
+
+    // sqrt(n) < 10^(c+1), so c+3 correct digits of 1/sqrt(X) put the root
+    // within a unit; two guard digits absorb the truncations of each step
+    int target = c + 3;
+    int prec = 12;
+    while (prec < target) {
+        prec = (2*prec < target) ? 2*prec : target;
+        int work = prec + 2;
+
+        BigFloat Xp = truncatedCopy(X, work);
+        BigFloat t = sqrBigFloat(v);
+        truncateDigits(&t, work);
+        replaceTruncated(&t, mulBigFloat(Xp, t), work);
+        replaceBigFloat(&t, subBigFloat(one, t));
+        replaceTruncated(&t, mulBigFloat(v, t), work);
+        replaceTruncated(&t, mulBigFloat(t, half), work);
+        addBigFloatInPlace(&v, t);
+        freeBigFloat(&t);
+        freeBigFloat(&Xp);
+    }
+
+    // root = X*v*10^c, truncated to an integer
+    BigFloat Xp = truncatedCopy(X, target + 2);
+    BigFloat root = mulBigFloat(Xp, v);
+    shiftDecimal(&root, c);
+    truncateDigits(&root, 0);
+    freeBigFloat(&Xp);
+    freeBigFloat(&X);
+    freeBigFloat(&v);
+    freeBigFloat(&half);
+
+    // fix up against rem = n - root^2, which must lie in [0, 2*root]
+    BigFloat rem = sqrBigFloat(root);
+    replaceBigFloat(&rem, subBigFloat(n, rem));
+    BigFloat step = { 0 };
+    while (rem.sign < 0) {
+        subBigFloatInPlace(&root, one);
+        addBigFloatTo(&step, root, root);
+        addBigFloatInPlace(&step, one);
+        addBigFloatInPlace(&rem, step);
+    }
+    for (;;) {
+        addBigFloatTo(&step, root, root);
+        addBigFloatInPlace(&step, one);
+        subBigFloatInPlace(&rem, step);
+        if (rem.sign < 0) {
+            addBigFloatInPlace(&rem, step);
+            break;
+        }
+        addBigFloatInPlace(&root, one);
+    }
+    freeBigFloat(&step);
+    freeBigFloat(&one);
+
+    if (remainder) *remainder = rem;
+    else freeBigFloat(&rem);
+    return root;
+}
+
+// Square root of x truncated to precision fractional digits, into *res;
+// on error zero is left there and -1 returned
+int sqrtBigFloatChecked(BigFloat x, int precision, BigFloat* res) {
+    STATS_OP(AAL_STAT_SQRT, x.len);
+    *res = zeroBigFloat();
+    if (x.len && x.sign < 0) {
+        fprintf(stderr, "Square root of a negative number!\n");
+        return -1;
+    }
+    if (x.len == 0) return 0;
+    if (precision < 0) precision = 0;
+
+    // x * 10^(2p) has to keep its shift and its top digit within an int
+    long long shift = 2LL * precision;
+    if (shift > INT_MAX || (long long)AAL_LIMB_DIGITS * ((long long)x.exp + x.len) + shift > INT_MAX) {
+        fprintf(stderr, "Precision too large!\n");
+        return -1;
+    }
+
+    // floor(sqrt(x) * 10^p) = floor(sqrt(floor(x * 10^(2p))))
+    BigFloat n = { 0 };
+    assignBigFloat(&n, x);
+    shiftDecimal(&n, (int)shift);
+    truncateDigits(&n, 0);
+    if (n.len == 0) {
+        *res = n;
+        return 0;
+    }
+
+    *res = isqrtRem(n, NULL);
+    shiftDecimal(res, -precision);
+    freeBigFloat(&n);
+    return 0;
+}
+
+// sqrtBigFloatChecked for callers that take zero for an error
+BigFloat sqrtBigFloat(BigFloat x, int precision) {
+    BigFloat res;
+    sqrtBigFloatChecked(x, precision, &res);
+    return res;
+}
+
+// Integer square root: root = floor(sqrt(x)) and remainder = x - root^2,
+// both exact; for integer x the remainder is an integer too
+void sqrtRemBigFloat(BigFloat x, BigFloat* root, BigFloat* remainder) {
+    STATS_OP(AAL_STAT_SQRT, x.len);
+    if (x.len && x.sign < 0) {
+        fprintf(stderr, "Square root of a negative number!\n");
+        *root = zeroBigFloat();
+        *remainder = zeroBigFloat();
+        return;
+    }
+
+    BigFloat n = truncatedCopy(x, 0);
+    if (n.len == 0) {
+        *root = n;
+        *remainder = zeroBigFloat();
+        assignBigFloat(remainder, x);
+        return;
+    }
+    *root = isqrtRem(n, remainder);
+    freeBigFloat(&n);
+
+    // the fraction of x was left out of n
+    if (x.exp < 0) {
+        BigFloat sq = sqrBigFloat(*root);
+        replaceBigFloat(remainder, subBigFloat(x, sq));
+        freeBigFloat(&sq);
+    }
+}
+
+// ---------- Modular arithmetic ----------
+// A modulus context keeps m next to its Barrett reciprocal mu =
+// floor(B^(2k) / m), so reducing anything below B^(2k) takes two
+// multiplications and no division (HAC 14.42). Montgomery's form would need
+// m coprime to the base 10^9; Barrett's works for every modulus. A built
+// context is only read, so threads may share one.
+
+struct AALModulus {
+    int k;          // limbs of m, the top one nonzero
+    int lmu;        // limbs of mu
+    limb_t* m;
+    limb_t* mu;
+};
+
+// Whether x has no fractional digits; its lowest limb is nonzero, so it is
+// fractional exactly when it sits below the point
+static int isIntegral(BigFloat x) {
+    return x.len == 0 || x.exp >= 0;
+}
+
+// The limbs of an integral x >= 0 with the zero limbs under its exponent
+// written out, into a fresh buffer of *len limbs
+static limb_t* integerLimbs(BigFloat x, int* len) {
+    int z = (x.len && x.exp > 0) ? x.exp : 0;
+    limb_t* r = limbsAlloc(x.len + z);
+    memset(r, 0, z * sizeof(limb_t));
+    memcpy(r + z, bigFloatLimbs(&x), x.len * sizeof(limb_t));
+    *len = x.len + z;
+    return r;
+}
+
+// r = x mod m for x < B^(2k) of lx limbs; r holds k limbs, zero padded.
+// quot, when given, receives floor(x / m) in lx-k+1 limbs (lx >= k then)
+static void barrettDivRem(const AALModulus* mod, limb_t* quot, limb_t* r, const limb_t* x, int lx) {
+    int k = mod->k;
+    int lq = lx - k + 1;
+    if (quot) memset(quot, 0, lq * sizeof(limb_t));
+    lx = limbsNormLen(x, lx);
+    if (lx < k) {
+        memcpy(r, x, lx * sizeof(limb_t));
+        memset(r + lx, 0, (k - lx) * sizeof(limb_t));
+        return;
+    }
+
+    // q = floor(floor(x / B^(k-1)) * mu / B^(k+1)) is at most 2 below x / m
+    int n1 = lx - (k-1);
+    int n2 = n1 + mod->lmu;
+    limb_t* q = limbsAlloc(n2);
+    limbsMul(q, x + k-1, n1, mod->mu, mod->lmu);
+    int n3 = (n2 > k+1) ? limbsNormLen(q + k+1, n2 - (k+1)) : 0;
+
+    // t = x - q*m lies in [0, 3m), so it can be formed mod B^(k+1)
+    limb_t* t = limbsAlloc(k+1);
+    int lt = (lx < k+1) ? lx : k+1;
+    memcpy(t, x, lt * sizeof(limb_t));
+    memset(t + lt, 0, (k+1 - lt) * sizeof(limb_t));
+    if (n3 > 0) {
+        limb_t* qm = limbsAlloc(n3 + k);
+        limbsMul(qm, q + k+1, n3, mod->m, k);
+        limbsSub(t, t, k+1, qm, k+1);   // the borrow out wraps mod B^(k+1)
+        limbsFree(qm);
+        if (quot) memcpy(quot, q + k+1, n3 * sizeof(limb_t));
+    }
+    while (limbsCmp(t, limbsNormLen(t, k+1), mod->m, k) >= 0) {
+        limbsSub(t, t, k+1, mod->m, k);
+        if (quot) {
+            limb_t one = 1;
+            limbsAdd(quot, quot, lq, &one, 1);
+        }
+    }
+
+    memcpy(r, t, k * sizeof(limb_t));
+    limbsFree(q);
+    limbsFree(t);
+}
+
+// r = x mod m in [0, m) for an integral x of any size; r holds k limbs
+static void modResidue(const AALModulus* mod, limb_t* r, BigFloat x) {
+    int k = mod->k;
+    if (x.len == 0) {
+        memset(r, 0, k * sizeof(limb_t));
+        return;
+    }
+    int len = x.len;
+    limb_t* owned = (x.exp > 0) ? integerLimbs(x, &len) : NULL;
+    const limb_t* n = owned ? owned : bigFloatLimbs(&x);
+
+    // fold k limbs at a time from the top: r = (r*B^k + chunk) mod m,
+    // where r*B^k + chunk < m*B^k stays in Barrett's range
+    int i = len - ((len % k) ? len % k : k);
+    barrettDivRem(mod, NULL, r, n + i, len - i);
+    if (i > 0) {
+        limb_t* t = limbsAlloc(2*k);
+        while (i > 0) {
+            i -= k;
+            memcpy(t, n + i, k * sizeof(limb_t));
+            memcpy(t + k, r, k * sizeof(limb_t));
+            barrettDivRem(mod, NULL, r, t, 2*k);
+        }
+        limbsFree(t);
+    }
+
+    // -x mod m = m - (x mod m)
+    if (x.sign < 0 && limbsNormLen(r, k) > 0) {
+        limb_t* t = limbsAlloc(k);
+        limbsSub(t, mod->m, k, r, k);
+        memcpy(r, t, k * sizeof(limb_t));
+        limbsFree(t);
+    }
+    limbsFree(owned);
+}
+
+// r = x*y mod m for residues of k limbs; r may be x or y, and x == y squares
+static void modMulResidues(const AALModulus* mod, limb_t* r, const limb_t* x, const limb_t* y) {
+    int k = mod->k;
+    limb_t* p = limbsAlloc(2*k);
+    limbsMul(p, x, k, y, k);
+    barrettDivRem(mod, NULL, r, p, 2*k);
+    limbsFree(p);
+}
+
+// Context for the normalized k limb modulus m
+static AALModulus* modulusFromLimbs(const limb_t* m, int k) {
+    AALModulus* mod = malloc(sizeof(AALModulus) + (2*k + 2) * sizeof(limb_t));
+    if (!mod) {
+        fprintf(stderr, "Out of memory!\n");
+        exit(1);
+    }
+    mod->k = k;
+    mod->m = (limb_t*)(mod + 1);
+    mod->mu = mod->m + k;
+    memcpy(mod->m, m, k * sizeof(limb_t));
+    mod->lmu = limbsInvert(mod->mu, mod->m, k);
+    return mod;
+}
+
+// Context for arithmetic modulo m, a positive integer; NULL when m is not one
+AALModulus* createAALModulus(BigFloat m) {
+    if (m.len == 0 || m.sign < 0 || !isIntegral(m)) {
+        fprintf(stderr, "Modulus must be a positive integer!\n");
+        return NULL;
+    }
+
+    int k;
+    limb_t* n = integerLimbs(m, &k);
+    AALModulus* mod = modulusFromLimbs(n, k);
+    limbsFree(n);
+    return mod;
+}
+
+void destroyAALModulus(AALModulus* mod) {
+    free(mod);
+}
+
+// x mod m in [0, m)
+BigFloat modReduceBigFloat(const AALModulus* mod, BigFloat x) {
+    if (!isIntegral(x)) {
+        fprintf(stderr, "Modular operands must be integers!\n");
+        return zeroBigFloat();
+    }
+    limb_t* r = limbsAlloc(mod->k);
+    modResidue(mod, r, x);
+    return makeBigFloat(r, mod->k, 0, 1);
+}
+
+// a*b mod m in [0, m)
+BigFloat modMulBigFloat(const AALModulus* mod, BigFloat a, BigFloat b) {
+    STATS_OP(AAL_STAT_MODMUL, mod->k);
+    if (!isIntegral(a) || !isIntegral(b)) {
+        fprintf(stderr, "Modular operands must be integers!\n");
+        return zeroBigFloat();
+    }
+    int k = mod->k;
+    limb_t* x = limbsAlloc(k);
+    limb_t* y = limbsAlloc(k);
+    modResidue(mod, x, a);
+    modResidue(mod, y, b);
+    modMulResidues(mod, x, x, y);
+    limbsFree(y);
+    return makeBigFloat(x, k, 0, 1);
+}
+
+// a^2 mod m in [0, m), on the squaring path of the multiplier
+BigFloat modSqrBigFloat(const AALModulus* mod, BigFloat a) {
+    STATS_OP(AAL_STAT_MODMUL, mod->k);
+    if (!isIntegral(a)) {
+        fprintf(stderr, "Modular operands must be integers!\n");
+        return zeroBigFloat();
+    }
+    limb_t* x = limbsAlloc(mod->k);
+    modResidue(mod, x, a);
+    modMulResidues(mod, x, x, x);
+    return makeBigFloat(x, mod->k, 0, 1);
+}
+
+// Window width for modPowBigFloat over an exponent of bits bits; its
+// exponents have any length, so the window keeps growing
+static int modPowWindow(int bits) {
+    if (bits < 8) return 1;
+    if (bits < 24) return 2;
+    if (bits < 80) return 3;
+    if (bits < 240) return 4;
+    if (bits < 800) return 5;
+    return 6;
+}
+
+// base^exponent mod m for an integer exponent >= 0, by sliding window
+// exponentiation over the exponent's bits
+BigFloat modPowBigFloat(const AALModulus* mod, BigFloat base, BigFloat exponent) {
+    STATS_OP(AAL_STAT_MODPOW, mod->k);
+    if (!isIntegral(base) || !isIntegral(exponent) || (exponent.len && exponent.sign < 0)) {
+        fprintf(stderr, "Modular power needs an integer base and exponent >= 0!\n");
+        return zeroBigFloat();
+    }
+    int k = mod->k;
+
+    // the exponent in binary, 30 bits per word
+    int elen;
+    limb_t* e = integerLimbs(exponent, &elen);
+    uint32_t* word = malloc((elen + 1) * sizeof(uint32_t));
+    int words = 0;
+    if (!word) {
+        fprintf(stderr, "Out of memory!\n");
+        exit(1);
+    }
+    while (elen > 0) {
+        word[words++] = limbsDivRem1(e, e, elen, 1u << 30);
+        elen = limbsNormLen(e, elen);
+    }
+    limbsFree(e);
+    int bits = (words > 0) ? 30 * (words-1) : 0;
+    for (uint32_t top = words ? word[words-1] : 0; top; top >>= 1) bits++;
+#define EXPONENT_BIT(i) ((word[(i) / 30] >> ((i) % 30)) & 1)
+
+    limb_t* acc = limbsAlloc(k);
+    BigFloat one = smallBigFloat(1, 0);
+    modResidue(mod, acc, one);
+    freeBigFloat(&one);
+
+    if (bits > 0) {
+        // odd powers base^1, base^3, ..., base^(2^w - 1)
+        int w = modPowWindow(bits);
+        int count = 1 << (w-1);
+        limb_t* odd = limbsAlloc(count * k);
+        modResidue(mod, odd, base);
+        if (count > 1) {
+            limb_t* base2 = limbsAlloc(k);
+            modMulResidues(mod, base2, odd, odd);
+            for (int i = 1; i < count; i++) modMulResidues(mod, odd + i*k, odd + (i-1)*k, base2);
+            limbsFree(base2);
+        }
+
+        int started = 0;
+        for (int i = bits-1; i >= 0; ) {
+            if (!EXPONENT_BIT(i)) {
+                modMulResidues(mod, acc, acc, acc);
+                i--;
+                continue;
+            }
+
+            // longest window e[i..j] of at most w bits with e[j] set
+            int j = (i - w + 1 > 0) ? i - w + 1 : 0;
+            while (!EXPONENT_BIT(j)) j++;
+            int value = 0;
+            for (int b = i; b >= j; b--) value = 2*value + EXPONENT_BIT(b);
+
+            if (started) {
+                for (int s = 0; s <= i - j; s++) modMulResidues(mod, acc, acc, acc);
+                modMulResidues(mod, acc, acc, odd + (value >> 1) * k);
+            } else {
+                memcpy(acc, odd + (value >> 1) * k, k * sizeof(limb_t));
+                started = 1;
+            }
+            i = j - 1;
+        }
+        limbsFree(odd);
+    }
+
+#undef EXPONENT_BIT
+    free(word);
+    return makeBigFloat(acc, k, 0, 1);
+}
+
+// ---------- Radix conversion ----------
+// Integers in radix 2 to 36, hex and binary being the usual ones. Both
+// directions divide and conquer on the powers P_k = r^(m * 2^k), r^m being
+// the largest power of the radix below one limb: formatting splits on P_k
+// with a Barrett division (two products, the reciprocal made once per
+// level), parsing joins with one product, so either costs O(M(n) log n).
+
+static const char radixDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Powers P_0 .. P_(count-1) built for one conversion
+typedef struct {
+    limb_t* p[32];
+    int len[32];
+    AALModulus* mod[32];    // Barrett contexts, made on first use
+    int count;
+    int m;          // digits of the radix per step of P_0
+} RadixPowers;
+
+static void radixPowersInit(RadixPowers* rp, int radix) {
+    limb_t p0 = radix;
+    rp->m = 1;
+    while ((uint64_t)p0 * radix < AAL_LIMB_BASE) {
+        p0 *= radix;
+        rp->m++;
+    }
+    memset(rp->mod, 0, sizeof(rp->mod));
+    rp->p[0] = limbsAlloc(1);
+    rp->p[0][0] = p0;
+    rp->len[0] = 1;
+    rp->count = 1;
+}
+
+// Append P_count = P_(count-1)^2
+static void radixPowersGrow(RadixPowers* rp) {
+    int k = rp->count;
+    int n = 2 * rp->len[k-1];
+    rp->p[k] = limbsAlloc(n);
+    limbsMul(rp->p[k], rp->p[k-1], rp->len[k-1], rp->p[k-1], rp->len[k-1]);
+    rp->len[k] = limbsNormLen(rp->p[k], n);
+    rp->count++;
+}
+
+static void radixPowersFree(RadixPowers* rp) {
+    for (int k = 0; k < rp->count; k++) {
+        limbsFree(rp->p[k]);
+        destroyAALModulus(rp->mod[k]);
+    }
+}
+
+// Value of a digit in any radix up to 36, or 36 for anything else
+static int radixDigitValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    return 36;
+}
+
+// Write x (n limbs, below P_k^2) as exactly 2*m*2^k digits, zero padded;
+// x is used as scratch
+static void limbsToRadix(char* out, limb_t* x, int n, int k, RadixPowers* rp, int radix) {
+    size_t half = (size_t)rp->m << k;
+    n = limbsNormLen(x, n);
+
+    if (n <= cutoffs.radix || k == 0) {
+        // peel m digits at a time off the bottom
+        char* p = out + 2 * half;
+        while (n > 0) {
+            limb_t v = limbsDivRem1(x, x, n, rp->p[0][0]);
+            n = limbsNormLen(x, n);
+            for (int j = 0; j < rp->m; j++) {
+                *--p = radixDigits[v % radix];
+                v /= radix;
+            }
+        }
+        memset(out, '0', p - out);
+        return;
+    }
+
+    // x = q*P_k + r with both halves below P_k = P_(k-1)^2; every node of
+    // a level divides by the same P_k, so its reciprocal is made once
+    int lp = rp->len[k];
+    if (n < lp) {
+        memset(out, '0', half);
+        limbsToRadix(out + half, x, n, k-1, rp, radix);
+        return;
+    }
+    limb_t* q = limbsAlloc(n - lp + 1);
+    limb_t* r = limbsAlloc(lp);
+    if (!rp->mod[k]) rp->mod[k] = modulusFromLimbs(rp->p[k], lp);
+    barrettDivRem(rp->mod[k], q, r, x, n);
+    limbsToRadix(out, q, n - lp + 1, k-1, rp, radix);
+    limbsToRadix(out + half, r, lp, k-1, rp, radix);
+    limbsFree(q);
+    limbsFree(r);
+}
+
+// Limbs of the n digits at s, all below the radix; the buffer is the
+// caller's to free
+static limb_t* limbsFromRadix(const char* s, size_t n, const RadixPowers* rp, int radix, int* len) {
+    if (n <= (size_t)cutoffs.radix * rp->m || rp->count == 1) {
+        // m digits at a time: r = r*radix^take + chunk
+        limb_t* r = limbsAlloc((int)(n / rp->m) + 1);
+        int k = 0;
+        size_t take = n % rp->m ? n % rp->m : (size_t)rp->m;
+        for (size_t i = 0; i < n; i += take, take = rp->m) {
+            limb_t v = 0, scale = 1;
+            for (size_t j = 0; j < take; j++) {
+                v = v * radix + radixDigitValue(s[i + j]);
+                scale *= radix;
+            }
+            limb_t carry = limbsMul1(r, r, k, scale);
+            if (carry) r[k++] = carry;
+            if (k == 0) {
+                if (v) r[k++] = v;
+            } else if (limbsAdd(r, r, k, &v, 1)) {
+                r[k++] = 1;
+            }
+        }
+        *len = k;
+        return r;
+    }
+
+    // the low m*2^k digits for the largest such k short of n, the rest high
+    int k = rp->count - 1;
+    while (((size_t)rp->m << k) >= n) k--;
+    size_t low = (size_t)rp->m << k;
+    int lh, ll, lp = rp->len[k];
+    limb_t* h = limbsFromRadix(s, n - low, rp, radix, &lh);
+    limb_t* l = limbsFromRadix(s + n - low, low, rp, radix, &ll);
+
+    // r = h*P_k + l, where l < P_k
+    int cap = lh + lp + 1;
+    limb_t* r = limbsAlloc(cap);
+    memset(r, 0, cap * sizeof(limb_t));
+    if (lh) limbsMul(r, h, lh, rp->p[k], lp);
+    limbsAdd(r, r, cap, l, ll);
+    *len = limbsNormLen(r, cap);
+    limbsFree(h);
+    limbsFree(l);
+    return r;
+}
+
+// Integer in radix 2 to 36 as text, lowercase and without a prefix;
+// NULL when bf has a fractional part
+char* formatBigFloatRadix(BigFloat bf, int radix) {
+    STATS_OP(AAL_STAT_FORMAT, bf.len);
+    if (radix < 2 || radix > 36) {
+        fprintf(stderr, "Radix must be between 2 and 36!\n");
+        return NULL;
+    }
+    if (bf.exp < 0) {
+        fprintf(stderr, "Radix conversion needs an integer!\n");
+        return NULL;
+    }
+    if (bf.len == 0) {
+        char* res = malloc(2);
+        if (res) strcpy(res, "0");
+        return res;
+    }
+
+    // the magnitude, with the zero limbs its exponent stands for
+    int n = bf.len + bf.exp;
+    limb_t* x = limbsAlloc(n);
+    memset(x, 0, bf.exp * sizeof(limb_t));
+    memcpy(x + bf.exp, bigFloatLimbs(&bf), bf.len * sizeof(limb_t));
+
+    // grow the powers until x < P_k^2 for the last one
+    RadixPowers rp;
+    radixPowersInit(&rp, radix);
+    while (2 * rp.len[rp.count-1] - 1 <= n) {
+        radixPowersGrow(&rp);
+        if (limbsCmp(rp.p[rp.count-1], rp.len[rp.count-1], x, n) > 0) {
+            limbsFree(rp.p[--rp.count]);
+            break;
+        }
+    }
+
+    size_t width = (size_t)2 * rp.m << (rp.count - 1);
+    char* res = malloc(width + 2);
+    if (res) {
+        limbsToRadix(res + 1, x, n, rp.count - 1, &rp, radix);
+        size_t skip = 1;
+        while (res[skip] == '0') skip++;
+        char* out = res;
+        if (bf.sign < 0) *out++ = '-';
+        memmove(out, res + skip, width + 1 - skip);
+        out[width + 1 - skip] = '\0';
+    }
+    radixPowersFree(&rp);
+    limbsFree(x);
+    return res;
+}
+
+// Parse an integer of exactly n characters at s in radix 2 to 36 (either
+// letter case, no prefix) into *bf; on error zero is left in *bf and -1
+// returned
+int readBigFloatRadix(const char* s, size_t n, int radix, BigFloat* bf) {
+    STATS_OP(AAL_STAT_PARSE, (int)(n / AAL_LIMB_DIGITS + 1));
+    const char* start = s;
+    const char* end = s + n;
+    int sign = 1;
+    *bf = zeroBigFloat();
+
+    if (radix < 2 || radix > 36) {
+        fprintf(stderr, "Radix must be between 2 and 36!\n");
+        return -1;
+    }
+    while (s < end && (*s == '+' || *s == '-')) {
+        if (*s == '-') sign = -sign;
+        s++;
+    }
+    const char* p = s;
+    while (p < end && radixDigitValue(*p) < radix) p++;
+    if (p == s || p != end || end - s > INT_MAX) {
+        int shown = n > 64 ? 64 : (int)n;
+        fprintf(stderr, "Invalid number format: %.*s%s\n", shown, start, n > 64 ? "..." : "");
+        return -1;
+    }
+    while (end - s > 1 && *s == '0') s++;
+
+    // P_k for every k with m*2^k digits short of the length
+    RadixPowers rp;
+    radixPowersInit(&rp, radix);
+    while (((size_t)rp.m << rp.count) < (size_t)(end - s)) radixPowersGrow(&rp);
+
+    int len;
+    limb_t* r = limbsFromRadix(s, end - s, &rp, radix, &len);
+    radixPowersFree(&rp);
+    *bf = makeBigFloat(r, len, 0, sign);
+    return 0;
+}
+
+// readBigFloatRadix for callers that take zero for a malformed number
+BigFloat parseBigFloatRadix(const char* s, size_t n, int radix) {
+    BigFloat res;
+    readBigFloatRadix(s, n, radix, &res);
+    return res;
+}
+
+// ---------- Digit string operations ----------
+// Thin wrappers over the limb kernels for callers still holding digit strings.
+
+// Compare two positive integers in string form
+int compareDigits(const char* a, const char* b) {
+    int la = strlen(a), lb = strlen(b);
+    if (la != lb) return (la > lb) ? 1 : -1;
+    return strcmp(a,b);
+}
+
+static limb_t* digitsToLimbs(const char* s, int* len) {
+    int n = strlen(s);
+    limb_t* r = limbsAlloc((n + AAL_LIMB_DIGITS - 1) / AAL_LIMB_DIGITS);
+    *len = limbsNormLen(r, limbsFromDecimal(r, s, n, NULL, 0, 0));
+    return r;
+}
+
+static char* limbsToDigits(const limb_t* a, int n) {
+    n = limbsNormLen(a, n);
+    char* res = malloc(limbsDecimalLen(a, n) + 1);
+    *limbsToDecimal(res, a, n) = '\0';
+    return res;
+}
+
+// Integer addition: |a| + |b|
+char* addDigits(const char* a, const char* b) {
+    int la, lb;
+    limb_t* x = digitsToLimbs(a, &la);
+    limb_t* y = digitsToLimbs(b, &lb);
+    BigFloat r = addMagnitudes(x, la, y, lb, 0, 0, 1);
+    char* res = formatBigFloat(r);
+    limbsFree(x); limbsFree(y); freeBigFloat(&r);
+    return res;
+}
+
+// Integer subtraction: |a| - |b|, assumes |a| >= |b|
+char* subDigits(const char* a, const char* b) {
+    int la, lb;
+    limb_t* x = digitsToLimbs(a, &la);
+    limb_t* y = digitsToLimbs(b, &lb);
+    BigFloat r = subMagnitudes(x, la, 0, y, lb, 0, 0, 1);
+    char* res = formatBigFloat(r);
+    limbsFree(x); limbsFree(y); freeBigFloat(&r);
+    return res;
+}
+
+// Integer multiplication: |a| * |b|
+char* mulDigits(const char* a, const char* b) {
+    int la, lb;
+    limb_t* x = digitsToLimbs(a, &la);
+    limb_t* y = digitsToLimbs(b, &lb);
+    limb_t* r = limbsAlloc(la + lb);
+    limbsMul(r, x, la, y, lb);
+    char* res = limbsToDigits(r, la + lb);
+    limbsFree(x); limbsFree(y); limbsFree(r);
+    return res;
+}
+
+// Integer division: returns quotient string (ignores remainder)
+// Computes floor(a * 10^precision / b), where a and b are non-negative digit strings
+// We have to specify the desired level of precision else the calculation will run on forever for repeating fractions etc.
+char* divDigits(const char* a, const char* b, int precision) {
+    BigFloat x = parseBigFloat(a);
+    BigFloat y = parseBigFloat(b);
+    BigFloat q = divBigFloat(x, y, precision);
+    shiftDecimal(&q, precision);
+    char* res = formatBigFloat(q);
+    freeBigFloat(&x); freeBigFloat(&y); freeBigFloat(&q);
+    return res;
+}
+
+// Division with remainder: returns the quotient string like divDigits and
+// stores a mod b, the remainder of the integer quotient, in *remainder
+char* divmodDigits(const char* a, const char* b, int precision, char** remainder) {
+    BigFloat x = parseBigFloat(a);
+    BigFloat y = parseBigFloat(b);
+    BigFloat q, r;
+    divmodBigFloat(x, y, precision, &q, &r);
+    shiftDecimal(&q, precision);
+    char* res = formatBigFloat(q);
+    *remainder = formatBigFloat(r);
+    freeBigFloat(&x); freeBigFloat(&y); freeBigFloat(&q); freeBigFloat(&r);
+    return res;
+}
+
+// Integer modulo: returns remainder string
+char* modDigits(const char* a, const char* b) {
+    BigFloat x = parseBigFloat(a);
+    BigFloat y = parseBigFloat(b);
+    BigFloat r = modBigFloat(x, y);
+    char* res = formatBigFloat(r);
+    freeBigFloat(&x); freeBigFloat(&y); freeBigFloat(&r);
     return res;
 }
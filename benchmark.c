@@ -10,18 +10,217 @@
 /* Headers */
 #include "headers/benchmark.h"
 
-/* Benchmark Function */
-long benchmark()
-{
-	struct timeval time;
-	long microtime = 0;
-	
-	gettimeofday(&time, NULL);
-	
-	microtime = time.tv_sec;
-	microtime += time.tv_usec / 1000;
-	
-	return microtime;
+/* Operations swept; the slow multiplication tiers stop early */
+static const BenchOp benchOps[] = {
+    {"add",            1, AAL_MUL_AUTO,       10000000},
+    {"sub",            2, AAL_MUL_AUTO,       10000000},
+    {"mul",            3, AAL_MUL_AUTO,       10000000},
+    {"mul_schoolbook", 3, AAL_MUL_SCHOOLBOOK, 100000},
+    {"mul_karatsuba",  3, AAL_MUL_KARATSUBA,  1000000},
+    {"mul_toom3",      3, AAL_MUL_TOOM3,      1000000},
+    {"mul_toom4",      3, AAL_MUL_TOOM4,      10000000},
+    {"mul_ntt",        3, AAL_MUL_NTT,        10000000},
+    {"sqr",            6, AAL_MUL_AUTO,       10000000},
+    {"div",            4, AAL_MUL_AUTO,       1000000},
+    {"mod",            5, AAL_MUL_AUTO,       1000000},
+    {"sqrt",           7, AAL_MUL_AUTO,       1000000},
+    {"modpow",         8, AAL_MUL_AUTO,       1000}
+};
+
+/* Monotonic clock in nanoseconds */
+long long benchmarkNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* Random digit string without a leading zero (xorshift, reproducible per seed) */
+char* randomDigits(long digits, unsigned long long* seed)
+{
+    char* s = malloc(digits + 1);
+    if (!s) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (long i = 0; i < digits; i++) {
+        *seed ^= *seed << 13;
+        *seed ^= *seed >> 7;
+        *seed ^= *seed << 17;
+        s[i] = '0' + (char)(*seed % 10);
+    }
+    if (s[0] == '0') s[0] = '1';
+    s[digits] = '\0';
+    return s;
+}
+
+/* Run one operation; division, modulo and square root are integer (precision 0) */
+BigFloat runBenchOp(const BenchOp* op, BigFloat a, BigFloat b)
+{
+    switch (op->operation) {
+        case 1: return addBigFloat(a, b);
+        case 2: return subBigFloat(a, b);
+        case 3: return mulBigFloatTier(a, b, op->tier);
+        case 4: return divBigFloat(a, b, 0);
+        case 5: return modBigFloat(a, b);
+        case 6: return sqrBigFloat(a);
+        case 7: return sqrtBigFloat(a, 0);
+        default: {
+            // a^b mod b, counting the modulus setup
+            AALModulus* mod = createAALModulus(b);
+            BigFloat r = modPowBigFloat(mod, a, b);
+            destroyAALModulus(mod);
+            return r;
+        }
+    }
+}
+
+static int compareNs(const void* x, const void* y)
+{
+    long long a = *(const long long*)x;
+    long long b = *(const long long*)y;
+    return (a > b) - (a < b);
+}
+
+/* Warm up once, then repeat until both the rep floor and minTimeNs are met */
+BenchResult measureOp(const BenchOp* op, BigFloat a, BigFloat b, long digits,
+                      long long minTimeNs, int maxReps)
+{
+    BenchResult res;
+    long long* samples = malloc(maxReps * sizeof(long long));
+    long long total = 0, start;
+    int n = 0;
+    if (!samples) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    start = benchmarkNs();
+    BigFloat warm = runBenchOp(op, a, b);
+    long long warmNs = benchmarkNs() - start;
+    freeBigFloat(&warm);
+
+    // multi second runs get a single timed rep
+    int minReps = (warmNs > 2000000000LL) ? 1 : 3;
+    if (minReps > maxReps) minReps = maxReps;
+
+    while (n < maxReps && (n < minReps || total < minTimeNs)) {
+        start = benchmarkNs();
+        BigFloat r = runBenchOp(op, a, b);
+        samples[n] = benchmarkNs() - start;
+        total += samples[n++];
+        freeBigFloat(&r);
+    }
+
+    qsort(samples, n, sizeof(long long), compareNs);
+    int p99 = (99 * n + 99) / 100 - 1;
+    res.reps = n;
+    res.minNs = samples[0];
+    res.medianNs = (n % 2) ? samples[n/2] : (samples[n/2 - 1] + samples[n/2]) / 2;
+    res.p99Ns = samples[p99 < 0 ? 0 : p99];
+    res.digitsPerSec = res.medianNs > 0 ? digits * 1e9 / res.medianNs : 0.0;
+
+    free(samples);
+    return res;
+}
+
+/* Check whether name is in a comma separated list */
+static int listed(const char* list, const char* name)
+{
+    size_t len = strlen(name);
+    for (const char* p = list; p; p = strchr(p, ',')) {
+        if (*p == ',') p++;
+        if (strncmp(p, name, len) == 0 && (p[len] == ',' || p[len] == '\0')) return 1;
+    }
+    return 0;
+}
+
+static void usage(const char* prog)
+{
+    fprintf(stderr,
+            "Usage: %s [--format csv|json] [--ops add,mul_ntt,...] [--max-digits N]\n"
+            "          [--min-time MS] [--max-reps N] [--threads N] [--no-caps]\n", prog);
+}
+
+/* Main Function */
+int main(int argc, char *argv[])
+{
+    const char* format = "csv";
+    const char* ops = NULL;
+    long maxDigits = 10000000;
+    long long minTimeNs = 200000000LL;
+    int maxReps = 1000;
+    int caps = 1;
+    int first = 1;
+
+    // time the crossover points tuned for this host, if $AAL_THRESHOLDS names them
+    if (loadAALThresholds(NULL) != 0) return 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i];
+        else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) ops = argv[++i];
+        else if (strcmp(argv[i], "--max-digits") == 0 && i + 1 < argc) maxDigits = atol(argv[++i]);
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) minTimeNs = atoll(argv[++i]) * 1000000LL;
+        else if (strcmp(argv[i], "--max-reps") == 0 && i + 1 < argc) maxReps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) setAALThreads(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--no-caps") == 0) caps = 0;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (maxReps < 1 || (strcmp(format, "csv") != 0 && strcmp(format, "json") != 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (format[0] == 'c') printf("op,digits,reps,median_ns,p99_ns,min_ns,digits_per_s\n");
+    else printf("[\n");
+
+    for (long digits = 10; digits <= maxDigits; digits *= 10) {
+        unsigned long long seed = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)digits;
+
+        // a is twice as long so division yields a digits sized quotient
+        char* sa = randomDigits(2 * digits, &seed);
+        char* sb = randomDigits(digits, &seed);
+        BigFloat wide = parseBigFloat(sa);
+        BigFloat a = parseBigFloatN(sa, digits);
+        BigFloat b = parseBigFloat(sb);
+        free(sa);
+        free(sb);
+
+        for (size_t i = 0; i < sizeof(benchOps) / sizeof(benchOps[0]); i++) {
+            const BenchOp* op = &benchOps[i];
+            if (ops && !listed(ops, op->name)) continue;
+            if (caps && digits > op->maxDigits) continue;
+
+            fprintf(stderr, "%s %ld...\n", op->name, digits);
+            BigFloat x = (op->operation == 4 || op->operation == 5) ? wide : a;
+            BenchResult r = measureOp(op, x, b, digits, minTimeNs, maxReps);
+
+            if (format[0] == 'c') {
+                printf("%s,%ld,%d,%lld,%lld,%lld,%.0f\n", op->name, digits, r.reps,
+                       r.medianNs, r.p99Ns, r.minNs, r.digitsPerSec);
+            } else {
+                printf("%s  {\"op\": \"%s\", \"digits\": %ld, \"reps\": %d, \"median_ns\": %lld, "
+                       "\"p99_ns\": %lld, \"min_ns\": %lld, \"digits_per_s\": %.0f}",
+                       first ? "" : ",\n", op->name, digits, r.reps,
+                       r.medianNs, r.p99Ns, r.minNs, r.digitsPerSec);
+                first = 0;
+            }
+            fflush(stdout);
+        }
+
+        freeBigFloat(&wide);
+        freeBigFloat(&a);
+        freeBigFloat(&b);
+    }
+
+    if (format[0] == 'j') printf("\n]\n");
+
+    setAALThreads(1);
+
+    return 0;
 }
 
 /******************************************************************************/
@@ -27,12 +27,135 @@ void safeStringInput(char* buffer, int maxLen) {
     }
 }
 
+/* Function to read a whole line of any length, returns NULL on EOF */
+char* readLine(FILE* in, size_t* outLen) {
+    size_t cap = 4096, len = 0;
+    char* line = malloc(cap);
+    int c;
+
+    if (!line) return NULL;
+    while ((c = fgetc(in)) != EOF && c != '\n') {
+        if (len + 1 == cap) {
+            char* grown = realloc(line, cap * 2);
+            if (!grown) {
+                free(line);
+                return NULL;
+            }
+            line = grown;
+            cap *= 2;
+        }
+        line[len++] = (char)c;
+    }
+    if (c == EOF && len == 0) {
+        free(line);
+        return NULL;
+    }
+    if (len > 0 && line[len-1] == '\r') len--;
+    line[len] = '\0';
+    *outLen = len;
+    return line;
+}
+
+/* Function to map a whole file read-only, falling back to reading it */
+int openInputView(const char* filename, InputView* view) {
+    view->data = NULL;
+    view->len = 0;
+    view->mapped = 0;
+
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            view->data = map;
+            view->len = (size_t)st.st_size;
+            view->mapped = 1;
+            close(fd);
+            return 1;
+        }
+    }
+    close(fd);
+#endif
+
+    // stream the file into one growing buffer
+    FILE* file = fopen(filename, "rb");
+    size_t cap = 1 << 16;
+    if (!file) return 0;
+    view->data = malloc(cap);
+    while (view->data) {
+        view->len += fread(view->data + view->len, 1, cap - view->len, file);
+        if (view->len < cap) break;
+        char* grown = realloc(view->data, cap * 2);
+        if (!grown) {
+            free(view->data);
+            view->data = NULL;
+            break;
+        }
+        view->data = grown;
+        cap *= 2;
+    }
+    fclose(file);
+    return view->data != NULL;
+}
+
+/* Function to release a view from openInputView */
+void closeInputView(InputView* view) {
+#ifndef _WIN32
+    if (view->mapped) {
+        munmap(view->data, view->len);
+        view->data = NULL;
+        return;
+    }
+#endif
+    free(view->data);
+    view->data = NULL;
+}
+
+/* Function to find the next operand in [*pos, end), separated by ':' or whitespace */
+int nextOperand(const char** pos, const char* end, const char** start, size_t* len) {
+    const char* p = *pos;
+    while (p < end && (*p == ':' || isspace((unsigned char)*p))) p++;
+    *start = p;
+    while (p < end && *p != ':' && !isspace((unsigned char)*p)) p++;
+    *len = (size_t)(p - *start);
+    *pos = p;
+    return *len > 0;
+}
+
+/* Function to echo an operand, eliding the middle of very long ones */
+void printOperand(const char* s, size_t len) {
+    if (len <= 64) {
+        printf("%.*s", (int)len, s);
+    } else {
+        printf("%.24s...%.24s (%lu digits)", s, s + len - 24, (unsigned long)len);
+    }
+}
+
+/* Function to read an integer exponent from an operand */
+int parseExponent(const char* s, size_t len, long* exponent) {
+    char buf[32];
+    char* endp;
+    if (len == 0 || len >= sizeof(buf)) return 0;
+    memcpy(buf, s, len);
+    buf[len] = '\0';
+    errno = 0;
+    *exponent = strtol(buf, &endp, 10);
+    return errno == 0 && *endp == '\0';
+}
+
 /* Function to perform the selected operation */
-void performOperation(int operation, const char* input1, const char* input2) {
-    BigFloat num1 = parseBigFloat(input1);
-    BigFloat num2 = parseBigFloat(input2);
-    BigFloat result;
-    char* resultStr;
+void performOperation(int operation, const char* input1, size_t len1,
+                      const char* input2, size_t len2, FILE* out) {
+    BigFloat num1 = parseBigFloatN(input1, len1);
+    BigFloat num2 = input2 ? parseBigFloatN(input2, len2) : parseBigFloat("0");
+    BigFloat result, remainder;
+    long exponent;
+    int hasRemainder = 0;
+    const char* symbol;
+    int precision = -1;
     long startTime, endTime;
     
     printf("\nCalculating...\n");
@@ -41,110 +164,439 @@ void performOperation(int operation, const char* input1, const char* input2) {
     switch(operation) {
         case 1: // Addition
             result = addBigFloat(num1, num2);
-            printf("Operation: %s + %s\n", input1, input2);
+            symbol = "+";
             break;
         case 2: // Subtraction
             result = subBigFloat(num1, num2);
-            printf("Operation: %s - %s\n", input1, input2);
+            symbol = "-";
             break;
         case 3: // Multiplication
             result = mulBigFloat(num1, num2);
-            printf("Operation: %s × %s\n", input1, input2);
+            symbol = "×";
             break;
         case 4: // Division
             printf("Enter precision (decimal places): ");
-            int precision;
             scanf("%d", &precision);
             getchar(); // consume newline
             result = divBigFloat(num1, num2, precision);
-            printf("Operation: %s ÷ %s (precision: %d)\n", input1, input2, precision);
+            symbol = "÷";
             break;
         case 5: // Modulo
             result = modBigFloat(num1, num2);
-            printf("Operation: %s mod %s\n", input1, input2);
+            symbol = "mod";
+            break;
+        case 6: // Power
+            if (!parseExponent(input2, len2, &exponent)) {
+                printf("Error: The exponent must be an integer\n");
+                freeBigFloat(&num1);
+                freeBigFloat(&num2);
+                return;
+            }
+            printf("Enter precision (decimal places, -1 for exact): ");
+            scanf("%d", &precision);
+            getchar(); // consume newline
+            result = powBigFloat(num1, exponent, precision);
+            symbol = "^";
+            break;
+        case 7: // Square root, integer part and remainder at precision 0
+            printf("Enter precision (decimal places): ");
+            scanf("%d", &precision);
+            getchar(); // consume newline
+            if (precision > 0) {
+                result = sqrtBigFloat(num1, precision);
+            } else {
+                sqrtRemBigFloat(num1, &result, &remainder);
+                hasRemainder = 1;
+            }
+            symbol = "sqrt";
+            break;
+        case 8: // Division & Modulo
+            printf("Enter precision (decimal places): ");
+            scanf("%d", &precision);
+            getchar(); // consume newline
+            divmodBigFloat(num1, num2, precision, &result, &remainder);
+            hasRemainder = 1;
+            symbol = "÷";
             break;
         default:
             printf("Invalid operation!\n");
+            freeBigFloat(&num1);
+            freeBigFloat(&num2);
             return;
     }
     
     endTime = getCurrentTimeMs();
     
-    resultStr = formatBigFloat(result);
-    printf("Result: %s\n", resultStr);
+    printf("Operation: ");
+    if (input2) {
+        printOperand(input1, len1);
+        printf(" %s ", symbol);
+        printOperand(input2, len2);
+    } else {
+        printf("%s ", symbol);
+        printOperand(input1, len1);
+    }
+    if (hasRemainder) printf(" with remainder");
+    if (precision >= 0) printf(" (precision: %d)", precision);
+    printf("\n");
+
+    // stream the digits instead of building one giant string
+    if (out == stdout) printf("Result: ");
+    fflush(stdout);
+    writeBigFloat(out, result);
+    fputc('\n', out);
+    if (hasRemainder) {
+        if (out == stdout) printf("Remainder: ");
+        writeBigFloat(out, remainder);
+        fputc('\n', out);
+        freeBigFloat(&remainder);
+    }
+    if (out != stdout) printf("Result written to file\n");
     printf("\nBenchmark :: Delay: %ldms\n", endTime - startTime);
     
     // Cleanup
-    free(resultStr);
-    free(num1.digits);
-    free(num2.digits);
-    free(result.digits);
+    freeBigFloat(&num1);
+    freeBigFloat(&num2);
+    freeBigFloat(&result);
 }
 
 /* Function to handle keyboard input */
 void handleKeyboardInput(int operation) {
-    char input1[10000];
-    char input2[10000];
+    char* input1;
+    char* input2 = NULL;
+    size_t len1, len2 = 0;
     
     printf("\n* --- %s --- *\n", 
            operation == 1 ? "Addition" :
            operation == 2 ? "Subtraction" :
            operation == 3 ? "Multiplication" :
            operation == 4 ? "Division" :
-           operation == 5 ? "Modulo" : "Unknown");
+           operation == 5 ? "Modulo" :
+           operation == 6 ? "Power" :
+           operation == 7 ? "Square Root" :
+           operation == 8 ? "Division & Modulo" : "Unknown");
     
     printf("Please enter number 1: ");
-    safeStringInput(input1, sizeof(input1));
+    input1 = readLine(stdin, &len1);
+    if (!input1) {
+        printf("Error: Could not read number 1\n");
+        return;
+    }
     
-    printf("Please enter number 2: ");
-    safeStringInput(input2, sizeof(input2));
+    // square roots take a single operand
+    if (operation != 7) {
+        printf(operation == 6 ? "Please enter the exponent: " : "Please enter number 2: ");
+        input2 = readLine(stdin, &len2);
+        if (!input2) {
+            printf("Error: Could not read number 2\n");
+            free(input1);
+            return;
+        }
+    }
     
-    performOperation(operation, input1, input2);
+    performOperation(operation, input1, len1, input2, len2, stdout);
+
+    free(input1);
+    free(input2);
 }
 
 /* Function to handle file input */
 void handleFileInput(int operation) {
     char filename[256];
-    FILE* file;
-    char input1[10000] = {0};
-    char input2[10000] = {0};
+    char outname[256];
+    InputView view;
+    const char *pos, *end, *input1, *input2 = NULL;
+    size_t len1, len2 = 0;
+    FILE* out = stdout;
     
     printf("\n* --- File Input --- *\n");
     printf("Enter filename: ");
     safeStringInput(filename, sizeof(filename));
     
-    file = fopen(filename, "r");
-    if (!file) {
+    if (!openInputView(filename, &view)) {
         printf("Error: Could not open file '%s'\n", filename);
         return;
     }
     
-    // Read two numbers from file
-    if (fgets(input1, sizeof(input1), file) == NULL) {
+    // Two numbers separated by ':' and/or newlines, as written by NumGen
+    pos = view.data;
+    end = view.data + view.len;
+    if (!nextOperand(&pos, end, &input1, &len1)) {
         printf("Error: Could not read first number from file\n");
-        fclose(file);
+        closeInputView(&view);
         return;
     }
     
-    if (fgets(input2, sizeof(input2), file) == NULL) {
+    if (operation != 7 && !nextOperand(&pos, end, &input2, &len2)) {
         printf("Error: Could not read second number from file\n");
-        fclose(file);
+        closeInputView(&view);
         return;
     }
     
-    fclose(file);
-    
-    // Remove newlines
-    size_t len1 = strlen(input1);
-    if (len1 > 0 && input1[len1-1] == '\n') input1[len1-1] = '\0';
-    
-    size_t len2 = strlen(input2);
-    if (len2 > 0 && input2[len2-1] == '\n') input2[len2-1] = '\0';
-    
-    printf("Number 1 from file: %s\n", input1);
-    printf("Number 2 from file: %s\n", input2);
+    printf("Number 1 from file: ");
+    printOperand(input1, len1);
+    if (input2) {
+        printf("\nNumber 2 from file: ");
+        printOperand(input2, len2);
+    }
+    printf("\n");
+
+    printf("Enter output filename (empty for screen): ");
+    outname[0] = '\0';
+    safeStringInput(outname, sizeof(outname));
+    if (outname[0] != '\0') {
+        out = fopen(outname, "w");
+        if (!out) {
+            printf("Error: Could not create file '%s'\n", outname);
+            closeInputView(&view);
+            return;
+        }
+    }
     
-    performOperation(operation, input1, input2);
+    performOperation(operation, input1, len1, input2, len2, out);
+
+    if (out != stdout && fclose(out) != 0) {
+        printf("Error: Could not write file '%s'\n", outname);
+    }
+    closeInputView(&view);
+}
+
+/* Utility function to get current time in nanoseconds */
+long long getCurrentTimeNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* Function to map a batch op name (or menu number) to an operation */
+int batchOperation(const char* name) {
+    static const struct { const char* name; int operation; } ops[] = {
+        {"add", 1}, {"sub", 2}, {"mul", 3}, {"div", 4}, {"mod", 5}, {"pow", 6}, {"sqrt", 7},
+        {"divmod", 8}, {"sqrtrem", 9},
+        {"1", 1}, {"2", 2}, {"3", 3}, {"4", 4}, {"5", 5}, {"6", 6}, {"7", 7}, {"8", 8}
+    };
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (strcmp(name, ops[i].name) == 0) return ops[i].operation;
+    }
+    return 0;
+}
+
+/* Function to resolve a batch operand; $N borrows the result of record N
+   unless that record failed, @file loads a number saved with saveBigFloat
+   and 0x / 0b prefix hex and binary integers. Returns 0 for a bad operand */
+int batchOperand(const char* tok, const BigFloat* results, const char* failedRecords, int count,
+                 BigFloat* value, int* owned) {
+    if (tok[0] == '$') {
+        char* endp;
+        long ref = strtol(tok + 1, &endp, 10);
+        if (endp == tok + 1 || *endp != '\0' || ref < 1 || ref > count || failedRecords[ref-1]) return 0;
+        *value = results[ref-1];
+        *owned = 0;
+        return 1;
+    }
+    if (tok[0] == '@') {
+        *owned = 1;
+        return readBigFloatFile(tok + 1, value) == 0;
+    }
+    *owned = 1;
+    if (tok[0] == '0' && tok[1] && strchr("xXbB", tok[1])) {
+        int radix = (tok[1] == 'x' || tok[1] == 'X') ? 16 : 2;
+        return readBigFloatRadix(tok + 2, strlen(tok + 2), radix, value) == 0;
+    }
+    return readBigFloatN(tok, strlen(tok), value) == 0;
+}
+
+/* Function to name what is wrong with a batch operand batchOperand refused */
+const char* batchOperandError(const char* tok) {
+    if (tok[0] == '$') return "bad reference";
+    return (tok[0] == '@') ? "bad file" : "bad number";
+}
+
+/* Function to read a batch precision: digits only, so neither negative
+   nor garbage precisions slip through as 0, and at most BATCH_MAX_PRECISION */
+int batchPrecision(const char* tok, int* precision) {
+    char* endp;
+    long value = strtol(tok, &endp, 10);
+    if (!isdigit((unsigned char)tok[0]) || *endp != '\0' || value > BATCH_MAX_PRECISION) return 0;
+    *precision = (int)value;
+    return 1;
+}
+
+/* Function to count the zero limbs an exact sum of a and b holds between
+   them, which grows with the gap between their magnitudes */
+long long batchGap(BigFloat a, BigFloat b) {
+    if (a.len == 0 || b.len == 0) return 0;
+    if (a.exp > b.exp) {
+        BigFloat t = a; a = b; b = t;
+    }
+    long long gap = (long long)b.exp - a.exp - a.len;
+    return gap > 0 ? gap : 0;
+}
+
+/* Function to check a batch record's operands against its operation's
+   domain; returns the error to report, or NULL */
+const char* batchDomainError(int operation, BigFloat num1, BigFloat num2, long exponent, int precision) {
+    switch (operation) {
+        case 1: case 2: return batchGap(num1, num2) > BATCH_MAX_GAP ? "result too large" : NULL;
+        case 4: case 8: return num2.len == 0 ? "division by zero" : NULL;
+        case 5: return num2.len == 0 ? "modulo by zero" : NULL;
+        case 6:
+            if (exponent < 0 && precision < 0) return "negative exponent needs a precision";
+            return (exponent < 0 && num1.len == 0) ? "division by zero" : NULL;
+        case 7: case 9: return (num1.len && num1.sign < 0) ? "negative square root" : NULL;
+        default: return NULL;
+    }
+}
+
+/* Function to write a batch result in the output radix; radices other
+   than 10 only take integers, and 0 is returned for anything else */
+int writeBatchValue(FILE* out, BigFloat value, int radix) {
+    if (radix == 10) {
+        writeBigFloat(out, value);
+        return 1;
+    }
+    char* s = formatBigFloatRadix(value, radix);
+    fputs(s ? s : "error", out);
+    free(s);
+    return s != NULL;
+}
+
+/* Function to run "op a b [precision]" records back to back */
+int runBatch(FILE* in, FILE* out, int radix) {
+    BigFloat* results = NULL;
+    char* failedRecords = NULL;
+    int count = 0, capacity = 0, failed = 0;
+    long long batchStart = getCurrentTimeNs();
+    char* line;
+    size_t len;
+
+    // operands, results and temporaries all come from one pooled arena
+    AALContext* ctx = createAALContext(0);
+    AALContext* previous = useAALContext(ctx);
+
+    // one large buffer so results are not flushed line by line
+    setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+    while ((line = readLine(in, &len)) != NULL) {
+        char* tokens[4];
+        int ntok = 0;
+        char* save = NULL;
+
+        for (char* t = strtok_r(line, " \t", &save); t && ntok < 4; t = strtok_r(NULL, " \t", &save)) {
+            tokens[ntok++] = t;
+        }
+
+        // blank lines and comments are not records
+        if (ntok == 0 || tokens[0][0] == '#') {
+            free(line);
+            continue;
+        }
+
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            results = realloc(results, capacity * sizeof(BigFloat));
+            failedRecords = realloc(failedRecords, capacity);
+            if (!results || !failedRecords) {
+                fprintf(stderr, "Out of memory\n");
+                exit(1);
+            }
+        }
+
+        int record = count + 1;
+        int operation = batchOperation(tokens[0]);
+        // square roots take one operand, powers are exact unless a
+        // precision is given
+        int operands = (operation == 7 || operation == 9) ? 1 : 2;
+        int precision = (operation == 6) ? -1 : 0;
+        BigFloat num1, num2 = { 0 }, remainder;
+        long exponent = 0;
+        int owned1 = 0, owned2 = 0;
+        const char* error = NULL;
+
+        // keep record numbers aligned with input even when a record fails;
+        // a failed record stays marked so $N cannot pick up its 0
+        results[count] = parseBigFloat("0");
+        failedRecords[count] = 1;
+        count++;
+
+        if (!operation || ntok < operands + 1) {
+            error = "bad record";
+        } else if (ntok > operands + 1 && !batchPrecision(tokens[operands + 1], &precision)) {
+            error = "bad precision";
+        } else if (operation == 6 && !parseExponent(tokens[2], strlen(tokens[2]), &exponent)) {
+            error = "bad exponent";
+        } else if (!batchOperand(tokens[1], results, failedRecords, record - 1, &num1, &owned1)) {
+            error = batchOperandError(tokens[1]);
+        } else if (operands == 2 && operation != 6 &&
+                   !batchOperand(tokens[2], results, failedRecords, record - 1, &num2, &owned2)) {
+            error = batchOperandError(tokens[2]);
+        } else {
+            error = batchDomainError(operation, num1, num2, exponent, precision);
+        }
+        if (error) {
+            fprintf(out, "%d\terror\t%s\n", record, error);
+            if (owned1) freeBigFloat(&num1);
+            if (owned2) freeBigFloat(&num2);
+            failed++;
+            free(line);
+            continue;
+        }
+
+        BigFloat result;
+        int status = 0;
+        long long start = getCurrentTimeNs();
+        switch (operation) {
+            case 1: result = addBigFloat(num1, num2); break;
+            case 2: result = subBigFloat(num1, num2); break;
+            case 3: result = mulBigFloat(num1, num2); break;
+            case 4: result = divBigFloat(num1, num2, precision); break;
+            case 5: result = modBigFloat(num1, num2); break;
+            case 6: status = powBigFloatChecked(num1, exponent, precision, &result); break;
+            case 7: status = sqrtBigFloatChecked(num1, precision, &result); break;
+            case 9: sqrtRemBigFloat(num1, &result, &remainder); break;
+            default: divmodBigFloat(num1, num2, precision, &result, &remainder); break;
+        }
+        long long elapsed = getCurrentTimeNs() - start;
+
+        // the domain was checked above, so only sizes out of range are left
+        if (status != 0) {
+            fprintf(out, "%d\terror\t%s\n", record, (operation == 6) ? "power too large" : "precision too large");
+            if (owned1) freeBigFloat(&num1);
+            if (owned2) freeBigFloat(&num2);
+            failed++;
+            free(line);
+            continue;
+        }
+
+        // record, elapsed microseconds, result [, remainder]
+        fprintf(out, "%d\t%lld\t", record, elapsed / 1000);
+        int written = writeBatchValue(out, result, radix);
+        if (operation == 8 || operation == 9) {
+            fputc('\t', out);
+            written = writeBatchValue(out, remainder, radix) && written;
+            freeBigFloat(&remainder);
+        }
+        fputc('\n', out);
+
+        freeBigFloat(&results[record-1]);
+        results[record-1] = result;
+        failedRecords[record-1] = !written;
+        if (!written) failed++;
+        if (owned1) freeBigFloat(&num1);
+        if (owned2) freeBigFloat(&num2);
+        free(line);
+    }
+
+    fflush(out);
+    fprintf(stderr, "Batch :: %d records (%d failed) in %lldms\n",
+            count, failed, (getCurrentTimeNs() - batchStart) / 1000000);
+
+    for (int i = 0; i < count; i++) freeBigFloat(&results[i]);
+    free(results);
+    free(failedRecords);
+    useAALContext(previous);
+    destroyAALContext(ctx);
+    return failed ? 1 : 0;
 }
 
 /* Main Function */
@@ -152,6 +604,42 @@ int main(int argc, char *argv[]) {
     int operation = 0;
     int inputMethod = 0;
     
+    /* Crossover points tuned for this host, if $AAL_THRESHOLDS names them */
+    loadAALThresholds(NULL);
+    
+    /* Batch Mode: specter --batch [file] [--threads N] [--radix N] [--stats] */
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        FILE* in = stdin;
+        int arg = 2;
+        int radix = 10;
+        int stats = 0;
+        if (arg < argc && strncmp(argv[arg], "--", 2) != 0) {
+            if (strcmp(argv[arg], "-") != 0) {
+                in = fopen(argv[arg], "r");
+                if (!in) {
+                    fprintf(stderr, "Error: Could not open file '%s'\n", argv[arg]);
+                    return 1;
+                }
+            }
+            arg++;
+        }
+        for (; arg < argc; arg++) {
+            if (strcmp(argv[arg], "--stats") == 0) stats = 1;
+            else if (arg + 1 < argc && strcmp(argv[arg], "--threads") == 0) setAALThreads(atoi(argv[++arg]));
+            else if (arg + 1 < argc && strcmp(argv[arg], "--radix") == 0) radix = atoi(argv[++arg]);
+        }
+        if (radix < 2 || radix > 36) {
+            fprintf(stderr, "Error: Radix must be between 2 and 36\n");
+            if (in != stdin) fclose(in);
+            return 1;
+        }
+        int status = runBatch(in, stdout, radix);
+        if (stats) writeAALStatsJson(stderr);
+        setAALThreads(1);
+        if (in != stdin) fclose(in);
+        return status;
+    }
+    
     /* Main Menu */
     printf("=====================\n");
     printf("*** Specter (AAL) ***\n");
@@ -164,8 +652,9 @@ int main(int argc, char *argv[]) {
     printf("3. Multiplication\n");
     printf("4. Division\n");
     printf("5. Modulo\n");
-    printf("6. Power (Not implemented)\n");
-    printf("7. Sqrt (Not implemented)\n");
+    printf("6. Power\n");
+    printf("7. Square Root\n");
+    printf("8. Division & Modulo\n");
     printf("0. Exit\n");
     printf("\n");
     printf("Select: ");
@@ -182,16 +671,11 @@ int main(int argc, char *argv[]) {
         return 0;
     }
     
-    if (operation < 1 || operation > 7) {
+    if (operation < 1 || operation > 8) {
         printf("\nWrong selection!\n");
         return 1;
     }
     
-    if (operation == 6 || operation == 7) {
-        printf("\nOperation not yet implemented in BigFloat library!\n");
-        return 1;
-    }
-    
     /* Input Method Selection */
     printf("\n\n\n");
     printf("1. Keyboard input\n");
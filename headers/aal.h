@@ -8,23 +8,172 @@
 #ifndef AAL_H
 #define AAL_H
 
-// BigFloat structure for arbitrary precision decimal arithmetic
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Each limb holds AAL_LIMB_DIGITS decimal digits (base 10^9)
+#define AAL_LIMB_DIGITS 9
+#define AAL_LIMB_BASE   1000000000u
+
+typedef uint32_t limb_t;
+
+// Significands of up to AAL_SMALL_LIMBS limbs (36 digits, 128 bits) are
+// kept inside the BigFloat itself and never touch the heap
+#define AAL_SMALL_LIMBS 4
+
+// BigFloat structure for arbitrary precision decimal arithmetic: the value
+// is sign * significand * 10^(9*exp), so zero limbs at either end are
+// never stored and 1e500000 takes a single limb
 typedef struct {
-    char *digits;   // only digits, no decimal point
-    int scale;      // number of fractional digits
+    limb_t *limbs;  // significand in base 10^9, least significant limb first,
+                    // or NULL while it sits in small
+    int len;        // limbs in use, no zero limb at either end (0 means zero)
+    int cap;        // limbs allocated
+    int exp;        // exponent in limbs
     int sign;       // +1 or -1
+    limb_t small[AAL_SMALL_LIMBS];
 } BigFloat;
 
+// Allocation context: an arena with size class pools that limb buffers
+// come from while it is the thread's current context (see useAALContext)
+typedef struct AALContext AALContext;
+
+// Modulus context: a fixed modulus with its precomputed Barrett reciprocal
+typedef struct AALModulus AALModulus;
+
+// Multiplication algorithms, in the order the automatic dispatch uses them
+typedef enum {
+    AAL_MUL_AUTO = 0,
+    AAL_MUL_SCHOOLBOOK,
+    AAL_MUL_KARATSUBA,
+    AAL_MUL_TOOM3,
+    AAL_MUL_TOOM4,
+    AAL_MUL_NTT
+} AALMulTier;
+
+// Evaluation contexts
+AALContext* createAALContext(size_t chunkBytes);
+void resetAALContext(AALContext* ctx);
+void destroyAALContext(AALContext* ctx);
+AALContext* useAALContext(AALContext* ctx);
+
+// Threads used for large multiplications (1 means serial)
+void setAALThreads(int threads);
+int getAALThreads(void);
+
+// Algorithm crossover points in limbs. They start at the *_CUTOFF compile
+// time defaults; the tune tool measures them on the host and writes a file
+// for loadAALThresholds, which reads $AAL_THRESHOLDS when path is NULL.
+// Not to be changed while an operation is running.
+typedef struct {
+    int karatsuba;  // schoolbook products up to this size
+    int toom3;      // Toom-3 from this size
+    int toom4;      // Toom-4 from this size
+    int ntt;        // NTT from this size
+    int mulHigh;    // schoolbook short products up to this size
+    int bz;         // Burnikel-Ziegler division from this divisor size
+    int newton;     // Newton division from this divisor size
+    int parallel;   // products from this size use the thread pool
+    int radix;      // radix conversion limb by limb up to this size
+} AALThresholds;
+
+void getAALThresholds(AALThresholds* t);
+int setAALThresholds(const AALThresholds* t);
+int loadAALThresholds(const char* path);
+int writeAALThresholds(FILE* f, const AALThresholds* t);
+
+// Statistics, gathered only when the library is built with AAL_STATS.
+// Calls and nanoseconds are per public operation, and an operation's time
+// includes the operations it is built from. limb_bits / sizes[op][b]
+// counts operands whose length in limbs has bit length b. Tier counts
+// include subproducts and recursive divisions.
+typedef enum {
+    AAL_STAT_PARSE = 0,
+    AAL_STAT_FORMAT,
+    AAL_STAT_ADD,
+    AAL_STAT_SUB,
+    AAL_STAT_MUL,
+    AAL_STAT_SQR,
+    AAL_STAT_DIV,           // division, modulo and divmod
+    AAL_STAT_SQRT,
+    AAL_STAT_POW,
+    AAL_STAT_MODMUL,        // modular products and squares
+    AAL_STAT_MODPOW,
+    AAL_STAT_OPS
+} AALStatOp;
+
+#define AAL_STAT_SIZE_BUCKETS 32
+
+typedef struct {
+    uint64_t calls[AAL_STAT_OPS];
+    uint64_t ns[AAL_STAT_OPS];
+    uint64_t sizes[AAL_STAT_OPS][AAL_STAT_SIZE_BUCKETS];
+    uint64_t mulTiers[AAL_MUL_NTT + 1];     // products by AALMulTier
+    uint64_t divTiers[3];                   // long, Burnikel-Ziegler, Newton
+    uint64_t karatsubaDepth;                // deepest Karatsuba recursion
+    uint64_t bytesAllocated;                // limb buffers handed out, in total
+    uint64_t liveBytes;
+    uint64_t peakLiveBytes;
+} AALStats;
+
+int snapshotAALStats(AALStats* stats);
+void resetAALStats(void);
+int writeAALStatsJson(FILE* f);
+
 // Core BigFloat operations
 BigFloat parseBigFloat(const char* s);
+BigFloat parseBigFloatN(const char* s, size_t n);
+int readBigFloatN(const char* s, size_t n, BigFloat* bf);
 char* formatBigFloat(BigFloat bf);
+size_t formatBigFloatLen(BigFloat bf);
+size_t formatBigFloatTo(char* out, BigFloat bf);
+int writeBigFloat(FILE* f, BigFloat bf);
+void freeBigFloat(BigFloat* bf);
+
+// Integers in radix 2 to 36 (hex, binary, ...), converted in O(M(n) log n)
+char* formatBigFloatRadix(BigFloat bf, int radix);
+BigFloat parseBigFloatRadix(const char* s, size_t n, int radix);
+int readBigFloatRadix(const char* s, size_t n, int radix, BigFloat* bf);
+
+// Binary files: versioned and checksummed, loaded without a copy where the
+// platform can map them
+int saveBigFloat(const char* path, BigFloat bf);
+BigFloat loadBigFloat(const char* path);
+int readBigFloatFile(const char* path, BigFloat* bf);
 
 // Arithmetic operations
 BigFloat addBigFloat(BigFloat a, BigFloat b);
 BigFloat subBigFloat(BigFloat a, BigFloat b);
 BigFloat mulBigFloat(BigFloat a, BigFloat b);
+BigFloat mulBigFloatTier(BigFloat a, BigFloat b, AALMulTier tier);
+BigFloat sqrBigFloat(BigFloat a);
+BigFloat mulBigFloatPrec(BigFloat a, BigFloat b, int precision);
+
+// Destination passing variants, reusing the destination's storage
+void addBigFloatTo(BigFloat* dst, BigFloat a, BigFloat b);
+void subBigFloatTo(BigFloat* dst, BigFloat a, BigFloat b);
+void mulBigFloatTo(BigFloat* dst, BigFloat a, BigFloat b);
+void addBigFloatInPlace(BigFloat* acc, BigFloat x);
+void subBigFloatInPlace(BigFloat* acc, BigFloat x);
+void mulAddBigFloat(BigFloat* acc, BigFloat a, BigFloat b);
+void mulSubBigFloat(BigFloat* acc, BigFloat a, BigFloat b);
 BigFloat divBigFloat(BigFloat a, BigFloat b, int precision);
 BigFloat modBigFloat(BigFloat a, BigFloat b);
+void divmodBigFloat(BigFloat a, BigFloat b, int precision, BigFloat* quotient, BigFloat* remainder);
+BigFloat powBigFloat(BigFloat base, long exponent, int precision);
+int powBigFloatChecked(BigFloat base, long exponent, int precision, BigFloat* res);
+BigFloat sqrtBigFloat(BigFloat x, int precision);
+int sqrtBigFloatChecked(BigFloat x, int precision, BigFloat* res);
+void sqrtRemBigFloat(BigFloat x, BigFloat* root, BigFloat* remainder);
+
+// Modular arithmetic against a fixed modulus; results lie in [0, m)
+AALModulus* createAALModulus(BigFloat m);
+void destroyAALModulus(AALModulus* mod);
+BigFloat modReduceBigFloat(const AALModulus* mod, BigFloat x);
+BigFloat modMulBigFloat(const AALModulus* mod, BigFloat a, BigFloat b);
+BigFloat modSqrBigFloat(const AALModulus* mod, BigFloat a);
+BigFloat modPowBigFloat(const AALModulus* mod, BigFloat base, BigFloat exponent);
 
 // Utility functions for digit string operations
 int compareDigits(const char* a, const char* b);
@@ -33,6 +182,7 @@ char* subDigits(const char* a, const char* b);
 char* mulDigits(const char* a, const char* b);
 char* divDigits(const char* a, const char* b, int precision);
 char* modDigits(const char* a, const char* b);
+char* divmodDigits(const char* a, const char* b, int precision, char** remainder);
 
 // Helper functions
 char* stripLeadingZeros(char* str);
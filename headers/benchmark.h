@@ -4,17 +4,45 @@
 /*                              George Delaportas                             */
 /*                            Copyright © 2010-2025                           */
 /******************************************************************************/
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
 
+/* Libraries */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
+/* AAL Header */
+#ifndef AAL_H
+#include "aal.h"
+#endif
 
-/* Libraries*/
-#include <stdlib.h>
-#include <sys/time.h>
+/* Operation under test, run on operands a and b */
+typedef struct {
+    const char* name;
+    int operation;          // 1 add, 2 sub, 3 mul, 4 div, 5 mod, 6 sqr, 7 sqrt, 8 modpow
+    AALMulTier tier;        // multiplication tier forced for op 3
+    long maxDigits;         // largest operand size worth sweeping
+} BenchOp;
 
-/* Benchmark Header Tag */
-#define __BENCHMARK_H__ 	1
+/* Timing summary of one op at one size */
+typedef struct {
+    int reps;
+    long long medianNs;
+    long long p99Ns;
+    long long minNs;
+    double digitsPerSec;
+} BenchResult;
 
-/* Benchmark Function*/
-long benchmark();
+/* Function declarations */
+long long benchmarkNs(void);
+char* randomDigits(long digits, unsigned long long* seed);
+BigFloat runBenchOp(const BenchOp* op, BigFloat a, BigFloat b);
+BenchResult measureOp(const BenchOp* op, BigFloat a, BigFloat b, long digits,
+                      long long minTimeNs, int maxReps);
 
-/******************************************************************************/
+/* Main Function */
+int main(int argc, char *argv[]);
+
+#endif /* __BENCHMARK_H__ */
@@ -12,18 +12,60 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <ctype.h>
+#include <limits.h>
+#include <errno.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 /* AAL Header */
 #ifndef AAL_H
 #include "aal.h"
 #endif
 
+/* Largest precision a batch record may ask for; doubled for a square root
+   and added to the digits of its operand it still fits the library's int
+   digit counts */
+#define BATCH_MAX_PRECISION 100000000
+
+/* Most zero limbs an exact batch sum or difference may fill in between its
+   operands (64 MB); 1e2147483647 + 1 would otherwise take a gigabyte */
+#define BATCH_MAX_GAP (1 << 24)
+
+/* Operand text: a read-only file mapping or a heap buffer */
+typedef struct {
+    char* data;
+    size_t len;
+    int mapped;
+} InputView;
+
 /* Function declarations */
 long getCurrentTimeMs(void);
 void safeStringInput(char* buffer, int maxLen);
-void performOperation(int operation, const char* input1, const char* input2);
+char* readLine(FILE* in, size_t* outLen);
+int openInputView(const char* filename, InputView* view);
+void closeInputView(InputView* view);
+int nextOperand(const char** pos, const char* end, const char** start, size_t* len);
+void printOperand(const char* s, size_t len);
+int parseExponent(const char* s, size_t len, long* exponent);
+void performOperation(int operation, const char* input1, size_t len1,
+                      const char* input2, size_t len2, FILE* out);
 void handleKeyboardInput(int operation);
 void handleFileInput(int operation);
+long long getCurrentTimeNs(void);
+int batchOperation(const char* name);
+int batchOperand(const char* tok, const BigFloat* results, const char* failedRecords, int count,
+                 BigFloat* value, int* owned);
+const char* batchOperandError(const char* tok);
+int batchPrecision(const char* tok, int* precision);
+long long batchGap(BigFloat a, BigFloat b);
+const char* batchDomainError(int operation, BigFloat num1, BigFloat num2, long exponent, int precision);
+int writeBatchValue(FILE* out, BigFloat value, int radix);
+int runBatch(FILE* in, FILE* out, int radix);
 
 /* Main Function */
 int main(int argc, char *argv[]);
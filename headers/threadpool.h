@@ -0,0 +1,32 @@
+/******************************************************************************/
+/*                                   Specter                                  */
+/*                           <<Thread Pool Header>>                           */
+/*                              George Delaportas                             */
+/*                            Copyright © 2010-2025                           */
+/******************************************************************************/
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+// Work stealing pool for fork/join style parallelism: every worker owns a
+// deque, pushes and pops its own tasks at the back and steals from the
+// front of the others. Waiting on a group runs queued tasks instead of
+// blocking, so tasks may spawn and wait on subtasks of their own.
+
+typedef struct ThreadPool ThreadPool;
+typedef void (*TaskFn)(void* arg);
+
+// Tasks spawned into a group, waited for together
+typedef struct {
+    int pending;
+} TaskGroup;
+
+// Pool of threads-1 workers; the thread that waits makes up the last one
+ThreadPool* createThreadPool(int threads);
+void destroyThreadPool(ThreadPool* pool);
+int threadPoolSize(const ThreadPool* pool);
+
+// Queue fn(arg) in group; arg must stay valid until the group is waited on
+void threadPoolSpawn(ThreadPool* pool, TaskGroup* group, TaskFn fn, void* arg);
+void threadPoolWait(ThreadPool* pool, TaskGroup* group);
+
+#endif // THREADPOOL_H
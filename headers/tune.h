@@ -0,0 +1,52 @@
+/******************************************************************************/
+/*                                   Specter                                  */
+/*                              <<Tuner Header>>                              */
+/*                              George Delaportas                             */
+/*                            Copyright © 2010-2025                           */
+/******************************************************************************/
+#ifndef __TUNE_H__
+#define __TUNE_H__
+
+/* Libraries */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+/* AAL Header */
+#ifndef AAL_H
+#include "aal.h"
+#endif
+
+/* One crossover point: the tier above it is timed against the tier below */
+typedef struct {
+    const char* name;       // key in the thresholds file
+    const char* macro;      // compile time default it overrides
+    size_t offset;          // field in AALThresholds
+    int operation;          // 1 mul, 2 short product, 3 div, 4 radix conversion
+    int upTo;               // 1 when the lower tier runs up to and including the value
+    int ordered;            // 1 when it cannot come before the previous entry's tier
+    int minLimbs;
+    int maxLimbs;
+    int sweepLimbs;         // 0 to find a crossover, else the operand size each value is timed on
+} TuneParam;
+
+/* Operands for one size */
+typedef struct {
+    BigFloat a;             // n limbs
+    BigFloat b;             // n limbs
+    BigFloat wide;          // 2n limbs, the dividend
+} TuneOperands;
+
+/* Function declarations */
+long long tuneNs(void);
+BigFloat randomLimbs(int limbs, unsigned long long* seed);
+long long timeOperation(int operation, const TuneOperands* x, int n, long long minTimeNs);
+int tuneParam(const TuneParam* param, int lo, int hi, AALThresholds* t, long long minTimeNs);
+int sweepParam(const TuneParam* param, int lo, int hi, AALThresholds* t, long long minTimeNs);
+
+/* Main Function */
+int main(int argc, char *argv[]);
+
+#endif /* __TUNE_H__ */
@@ -0,0 +1,226 @@
+/******************************************************************************/
+/*                                   Specter                                  */
+/*                               <<Thread Pool>>                              */
+/*                              George Delaportas                             */
+/*                            Copyright © 2010-2025                           */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "headers/threadpool.h"
+
+typedef struct {
+    TaskFn fn;
+    void* arg;
+    TaskGroup* group;
+} Task;
+
+// Ring buffer of tasks: the owner works at the back, thieves at the front
+typedef struct {
+    pthread_mutex_t lock;
+    Task* tasks;
+    int head;
+    int count;
+    int cap;
+} TaskDeque;
+
+struct ThreadPool {
+    int workers;
+    pthread_t* threads;
+    TaskDeque* deques;      // one per worker, plus one for outside threads
+    int queued;             // tasks sitting in any deque
+    int shutdown;
+    pthread_mutex_t lock;   // guards sleeping, not the deques
+    pthread_cond_t wake;
+};
+
+// Which pool and deque the current thread works for
+static __thread ThreadPool* selfPool = NULL;
+static __thread int selfIndex = 0;
+
+static void dequePush(TaskDeque* d, Task t) {
+    pthread_mutex_lock(&d->lock);
+    if (d->count == d->cap) {
+        int cap = d->cap ? 2 * d->cap : 64;
+        Task* tasks = malloc(cap * sizeof(Task));
+        if (!tasks) {
+            fprintf(stderr, "Out of memory!\n");
+            exit(1);
+        }
+        for (int i = 0; i < d->count; i++) tasks[i] = d->tasks[(d->head + i) % d->cap];
+        free(d->tasks);
+        d->tasks = tasks;
+        d->head = 0;
+        d->cap = cap;
+    }
+    d->tasks[(d->head + d->count) % d->cap] = t;
+    d->count++;
+    pthread_mutex_unlock(&d->lock);
+}
+
+// Take from the back (own deque) or the front (stealing)
+static int dequeTake(TaskDeque* d, Task* t, int back) {
+    int found = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->count > 0) {
+        if (back) {
+            *t = d->tasks[(d->head + d->count - 1) % d->cap];
+        } else {
+            *t = d->tasks[d->head];
+            d->head = (d->head + 1) % d->cap;
+        }
+        d->count--;
+        found = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return found;
+}
+
+// Newest task of our own deque, else the oldest task of another
+static int takeTask(ThreadPool* pool, int self, Task* t) {
+    int n = pool->workers + 1;
+    if (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) return 0;
+    if (dequeTake(&pool->deques[self], t, 1)) goto taken;
+    for (int i = 1; i < n; i++) {
+        if (dequeTake(&pool->deques[(self + i) % n], t, 0)) goto taken;
+    }
+    return 0;
+
+taken:
+    __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+    return 1;
+}
+
+static void runTask(Task* t) {
+    t->fn(t->arg);
+    __atomic_sub_fetch(&t->group->pending, 1, __ATOMIC_RELEASE);
+}
+
+static void* workerMain(void* arg) {
+    ThreadPool* pool = selfPool;
+    int self = selfIndex;
+    Task t;
+    (void)arg;
+
+    for (;;) {
+        if (takeTask(pool, self, &t)) {
+            runTask(&t);
+            continue;
+        }
+
+        // nothing to do: sleep until a spawn or shutdown
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        int stop = pool->shutdown;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop) return NULL;
+    }
+}
+
+typedef struct {
+    ThreadPool* pool;
+    int index;
+} WorkerStart;
+
+static void* workerEntry(void* arg) {
+    WorkerStart start = *(WorkerStart*)arg;
+    free(arg);
+    selfPool = start.pool;
+    selfIndex = start.index;
+    return workerMain(NULL);
+}
+
+ThreadPool* createThreadPool(int threads) {
+    ThreadPool* pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+    pool->workers = threads > 1 ? threads - 1 : 0;
+    pool->threads = calloc(pool->workers + 1, sizeof(pthread_t));
+    pool->deques = calloc(pool->workers + 1, sizeof(TaskDeque));
+    if (!pool->threads || !pool->deques) {
+        free(pool->threads);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    for (int i = 0; i <= pool->workers; i++) pthread_mutex_init(&pool->deques[i].lock, NULL);
+
+    for (int i = 0; i < pool->workers; i++) {
+        WorkerStart* start = malloc(sizeof(WorkerStart));
+        if (start) {
+            start->pool = pool;
+            start->index = i;
+        }
+        if (!start || pthread_create(&pool->threads[i], NULL, workerEntry, start) != 0) {
+            // run with the workers we did get
+            free(start);
+            fprintf(stderr, "Could not start worker thread %d\n", i);
+            pool->workers = i;
+            break;
+        }
+    }
+    return pool;
+}
+
+void destroyThreadPool(ThreadPool* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->workers; i++) pthread_join(pool->threads[i], NULL);
+
+    for (int i = 0; i <= pool->workers; i++) {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+        free(pool->deques[i].tasks);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    free(pool->deques);
+    free(pool->threads);
+    free(pool);
+}
+
+int threadPoolSize(const ThreadPool* pool) {
+    return pool ? pool->workers + 1 : 1;
+}
+
+// Deque the calling thread pushes to: its own, or the shared outside one
+static int ownDeque(ThreadPool* pool) {
+    return (selfPool == pool) ? selfIndex : pool->workers;
+}
+
+void threadPoolSpawn(ThreadPool* pool, TaskGroup* group, TaskFn fn, void* arg) {
+    Task t;
+    t.fn = fn;
+    t.arg = arg;
+    t.group = group;
+    __atomic_add_fetch(&group->pending, 1, __ATOMIC_RELAXED);
+
+    // counted before it is visible, so the count never runs negative
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_RELEASE);
+    dequePush(&pool->deques[ownDeque(pool)], t);
+
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void threadPoolWait(ThreadPool* pool, TaskGroup* group) {
+    int self = ownDeque(pool);
+    Task t;
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+        // help out rather than block, our own subtasks are usually on top
+        if (takeTask(pool, self, &t)) runTask(&t);
+        else sched_yield();
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,329 @@
+/******************************************************************************/
+/*                                   Specter                                  */
+/*                                  <<Tuner>>                                 */
+/*                              George Delaportas                             */
+/*                            Copyright © 2010-2025                           */
+/******************************************************************************/
+
+
+
+/* Headers */
+#include "headers/tune.h"
+
+/* Crossover points in the order they are tuned; each one is measured with
+   the ones before it already in place and the ones after it switched off.
+   Radix conversion builds a reciprocal per level of its tree that the whole
+   level shares, so one split says little and its cutoff is swept instead */
+static const TuneParam tuneParams[] = {
+    {"karatsuba", "KARATSUBA_CUTOFF", offsetof(AALThresholds, karatsuba), 1, 1, 0, 4,   200,   0},
+    {"toom3",     "TOOM3_CUTOFF",     offsetof(AALThresholds, toom3),     1, 0, 1, 5,   1500,  0},
+    {"toom4",     "TOOM4_CUTOFF",     offsetof(AALThresholds, toom4),     1, 0, 1, 10,  5000,  0},
+    {"ntt",       "NTT_CUTOFF",       offsetof(AALThresholds, ntt),       1, 0, 1, 10,  50000, 0},
+    {"mulhigh",   "MULHIGH_CUTOFF",   offsetof(AALThresholds, mulHigh),   2, 1, 0, 3,   1500,  0},
+    {"bz",        "BZ_CUTOFF",        offsetof(AALThresholds, bz),        3, 0, 0, 4,   2000,  0},
+    {"newton",    "NEWTON_CUTOFF",    offsetof(AALThresholds, newton),    3, 0, 1, 8,   50000, 0},
+    {"radix",     "RADIX_CUTOFF",     offsetof(AALThresholds, radix),     4, 1, 0, 2,   500,   4000},
+    {"parallel",  "PARALLEL_CUTOFF",  offsetof(AALThresholds, parallel),  1, 0, 0, 100, 20000, 0}
+};
+
+#define TUNE_PARAMS (int)(sizeof(tuneParams) / sizeof(tuneParams[0]))
+
+/* Sizes in a row the upper tier has to win before it counts as the crossover */
+#define TUNE_WINS 3
+
+/* Monotonic clock in nanoseconds */
+long long tuneNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int* paramField(AALThresholds* t, const TuneParam* param)
+{
+    return (int*)((char*)t + param->offset);
+}
+
+/* Random integer of exactly limbs limbs (xorshift, reproducible per seed) */
+BigFloat randomLimbs(int limbs, unsigned long long* seed)
+{
+    long digits = (long)limbs * AAL_LIMB_DIGITS;
+    char* s = malloc(digits + 1);
+    if (!s) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (long i = 0; i < digits; i++) {
+        *seed ^= *seed << 13;
+        *seed ^= *seed >> 7;
+        *seed ^= *seed << 17;
+        s[i] = '0' + (char)(*seed % 10);
+    }
+    // nonzero at both ends, so no limb is stripped
+    if (s[0] == '0') s[0] = '1';
+    if (s[digits - 1] == '0') s[digits - 1] = '1';
+    s[digits] = '\0';
+    BigFloat bf = parseBigFloat(s);
+    free(s);
+    return bf;
+}
+
+/* Run one operation on n limb operands */
+static void runOperation(int operation, const TuneOperands* x, int n)
+{
+    BigFloat r;
+    switch (operation) {
+        case 1:
+            r = mulBigFloat(x->a, x->b);
+            break;
+        case 2: {
+            // the top n limbs of the product of two n limb fractions
+            BigFloat a = x->a, b = x->b;
+            a.exp = b.exp = -n;
+            r = mulBigFloatPrec(a, b, AAL_LIMB_DIGITS * n);
+            break;
+        }
+        case 3:
+            r = divBigFloat(x->wide, x->b, 0);
+            break;
+        default: {
+            // to hex and back, both ways split at the same cutoff
+            char* s = formatBigFloatRadix(x->a, 16);
+            r = parseBigFloatRadix(s, strlen(s), 16);
+            free(s);
+            break;
+        }
+    }
+    freeBigFloat(&r);
+}
+
+/* Average time of one operation, over enough runs to fill minTimeNs */
+long long timeOperation(int operation, const TuneOperands* x, int n, long long minTimeNs)
+{
+    long long start = tuneNs(), elapsed;
+    int reps = 0;
+    do {
+        runOperation(operation, x, n);
+        reps++;
+        elapsed = tuneNs() - start;
+    } while (elapsed < minTimeNs);
+    return elapsed / reps;
+}
+
+/* Set param to value in t and in the library; a value the library rejects
+   leaves both as they were and returns 0 */
+static int applyParam(AALThresholds* t, const TuneParam* param, int value)
+{
+    int* field = paramField(t, param);
+    int old = *field;
+    *field = value;
+    if (setAALThresholds(t) == 0) return 1;
+    *field = old;
+    return 0;
+}
+
+/* Find the first size in [lo, hi] from which the upper tier wins TUNE_WINS
+   sizes in a row, with the upper tier switched on exactly at each size tried
+   so that its subproducts stay on the lower tiers. Sizes whose setting the
+   library rejects are skipped and end a run of wins. Sets and returns the
+   value, or -1 when the tier cannot be switched off or set */
+int tuneParam(const TuneParam* param, int lo, int hi, AALThresholds* t, long long minTimeNs)
+{
+    int found = 0, first = 0, wins = 0, failed = 0;
+
+    // off is one short of INT_MAX so the tiers after it can stay above it
+    for (int n = lo; n <= hi && !found && !failed; n += (n / 10 > 0) ? n / 10 : 1) {
+        int value = param->upTo ? n - 1 : n;
+        if (!applyParam(t, param, value)) {
+            fprintf(stderr, "%s %d: rejected\n", param->name, n);
+            wins = 0;
+            continue;
+        }
+
+        unsigned long long seed = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)n;
+        TuneOperands x;
+        x.a = randomLimbs(n, &seed);
+        x.b = randomLimbs(n, &seed);
+        x.wide = randomLimbs(2 * n, &seed);
+
+        // interleaved, keeping the best of three of each
+        long long on = LLONG_MAX, off = LLONG_MAX;
+        for (int i = 0; i < 3 && !failed; i++) {
+            failed = !applyParam(t, param, value);
+            if (failed) break;
+            long long ns = timeOperation(param->operation, &x, n, minTimeNs);
+            if (ns < on) on = ns;
+
+            failed = !applyParam(t, param, INT_MAX - 1);
+            if (failed) break;
+            ns = timeOperation(param->operation, &x, n, minTimeNs);
+            if (ns < off) off = ns;
+        }
+
+        if (!failed) {
+            fprintf(stderr, "%s %d: %lld ns, %lld ns below\n", param->name, n, on, off);
+            if (on < off) {
+                if (wins++ == 0) first = n;
+            } else {
+                wins = 0;
+            }
+            if (wins == TUNE_WINS) found = first;
+        }
+
+        freeBigFloat(&x.a);
+        freeBigFloat(&x.b);
+        freeBigFloat(&x.wide);
+    }
+    if (failed) return -1;
+
+    // a run of wins cut short by the end of the range still counts
+    if (!found && wins > 0) found = first;
+    if (!found) {
+        fprintf(stderr, "%s: no crossover up to %d limbs\n", param->name, hi);
+        found = (hi > lo) ? hi : lo;
+    }
+    if (!applyParam(t, param, param->upTo ? found - 1 : found)) return -1;
+    return *paramField(t, param);
+}
+
+/* Try each value in [lo, hi] on operands of param->sweepLimbs limbs and
+   half as many again, so that no one alignment of the tree decides, and
+   keep the fastest. Values the library rejects are skipped. Sets and
+   returns the value, or -1 when no value was accepted */
+int sweepParam(const TuneParam* param, int lo, int hi, AALThresholds* t, long long minTimeNs)
+{
+    int sizes[2] = { param->sweepLimbs, param->sweepLimbs * 3 / 2 };
+    TuneOperands x[2];
+    for (int i = 0; i < 2; i++) {
+        unsigned long long seed = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)sizes[i];
+        x[i].a = randomLimbs(sizes[i], &seed);
+        x[i].b = randomLimbs(sizes[i], &seed);
+        x[i].wide = randomLimbs(2 * sizes[i], &seed);
+    }
+
+    int best = -1;
+    long long bestNs = LLONG_MAX;
+    for (int v = lo; v <= hi; v += (v / 10 > 0) ? v / 10 : 1) {
+        if (!applyParam(t, param, v)) {
+            fprintf(stderr, "%s %d: rejected\n", param->name, v);
+            continue;
+        }
+        long long ns = LLONG_MAX;
+        for (int round = 0; round < 2; round++) {
+            long long sum = 0;
+            for (int i = 0; i < 2; i++) sum += timeOperation(param->operation, &x[i], sizes[i], minTimeNs);
+            if (sum < ns) ns = sum;
+        }
+        fprintf(stderr, "%s %d: %lld ns\n", param->name, v, ns);
+        if (ns < bestNs) {
+            bestNs = ns;
+            best = v;
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        freeBigFloat(&x[i].a);
+        freeBigFloat(&x[i].b);
+        freeBigFloat(&x[i].wide);
+    }
+    if (best < 0 || !applyParam(t, param, best)) return -1;
+    return best;
+}
+
+/* Write t as a header of the compile time defaults */
+static int writeHeader(FILE* f, const AALThresholds* t)
+{
+    AALThresholds c = *t;
+    fprintf(f, "/* Crossover points measured by tune; build with -include this file */\n");
+    fprintf(f, "#ifndef AAL_THRESHOLDS_H\n#define AAL_THRESHOLDS_H\n\n");
+    for (int i = 0; i < TUNE_PARAMS; i++) {
+        fprintf(f, "#define %s %d\n", tuneParams[i].macro, *paramField(&c, &tuneParams[i]));
+    }
+    fprintf(f, "\n#endif\n");
+    return ferror(f) ? -1 : 0;
+}
+
+static void usage(const char* prog)
+{
+    fprintf(stderr,
+            "Usage: %s [--out FILE] [--header FILE] [--min-time MS] [--threads N]\n", prog);
+}
+
+/* Main Function */
+int main(int argc, char *argv[])
+{
+    const char* out = NULL;
+    const char* header = NULL;
+    long long minTimeNs = 2000000LL;
+    int threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out = argv[++i];
+        else if (strcmp(argv[i], "--header") == 0 && i + 1 < argc) header = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) minTimeNs = atoll(argv[++i]) * 1000000LL;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (minTimeNs <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // every tier off to begin with; the parallel cutoff is only measured
+    // with threads to share the work
+    AALThresholds t;
+    getAALThresholds(&t);
+    int parallel = t.parallel;
+    for (int i = 0; i < TUNE_PARAMS; i++) *paramField(&t, &tuneParams[i]) = INT_MAX;
+    t.karatsuba = INT_MAX - 1;
+    if (setAALThresholds(&t) != 0) return 1;
+    setAALThreads(threads);
+
+    for (int i = 0; i < TUNE_PARAMS; i++) {
+        const TuneParam* param = &tuneParams[i];
+        if (param->offset == offsetof(AALThresholds, parallel) && threads < 2) {
+            t.parallel = parallel;
+            continue;
+        }
+
+        int lo = param->minLimbs, hi = param->maxLimbs;
+        if (param->ordered) {
+            int prev = *paramField(&t, param - 1) + (param - 1)->upTo;
+            if (prev > lo) lo = prev;
+        }
+        // short products are only cut up to the Toom-3 cutoff
+        if (param->operation == 2 && t.toom3 < hi) hi = t.toom3;
+        int v = param->sweepLimbs ? sweepParam(param, lo, hi, &t, minTimeNs)
+                                  : tuneParam(param, lo, hi, &t, minTimeNs);
+        if (v < 0) {
+            fprintf(stderr, "Error: Could not tune %s\n", param->name);
+            setAALThreads(1);
+            return 1;
+        }
+        fprintf(stderr, "%s: %d\n", param->name, v);
+    }
+    setAALThreads(1);
+
+    FILE* f = out ? fopen(out, "w") : stdout;
+    if (!f) {
+        fprintf(stderr, "Error: Could not write '%s'\n", out);
+        return 1;
+    }
+    fprintf(f, "# Specter-AAL crossover points in limbs, measured by tune\n");
+    int status = writeAALThresholds(f, &t);
+    if (out && fclose(f) != 0) status = -1;
+
+    if (header) {
+        f = fopen(header, "w");
+        if (!f || writeHeader(f, &t) != 0) status = -1;
+        if (f && fclose(f) != 0) status = -1;
+    }
+    if (status != 0) fprintf(stderr, "Error: Could not write the thresholds\n");
+
+    return status ? 1 : 0;
+}
+
+/******************************************************************************/